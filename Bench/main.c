@@ -0,0 +1,193 @@
+#include <time.h>
+#include "HTTPParserBenchCorpus.h"
+
+#define DEFAULT_ITERATIONS 20000
+#define MESSAGE_BUFFER_SIZE 4096
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define NANOSECONDS_IN_SECOND 1000000000ULL
+
+typedef void (*BenchFunction)(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser);
+
+typedef struct BenchCase {
+    const char *name;
+    BenchFunction run;
+} BenchCase;
+
+typedef struct BenchProfile {
+    const char *name;
+    uint8_t validationChecks;
+} BenchProfile;
+
+#if defined(HTTP_BENCH_COUNT_ALLOCATIONS)
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+static size_t allocationCount = 0;
+
+void *__wrap_malloc(size_t size) {
+    allocationCount++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocationCount++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size) {
+    allocationCount++;
+    return __real_realloc(pointer, size);
+}
+#endif
+
+
+static void benchParseHttpBuffer(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser) {
+    (void) length;
+    parseHttpBuffer(buffer, parser, message->httpType);
+}
+
+static void benchParseHttpBufferWithHeaders(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser) {
+    (void) length;
+    parseHttpBuffer(buffer, parser, message->httpType);
+    parseHttpHeaders(parser, buffer);
+}
+
+static void benchParseHttpQueryParameters(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser) {
+    (void) message;
+    (void) length;
+    parseHttpQueryParameters(parser, buffer);
+}
+
+static void benchParseHttpMessage(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser) {
+    (void) length;
+    parseHttpMessage(buffer, parser, message->httpType);
+}
+
+static void benchParseHttpBufferN(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser) {
+    parseHttpBufferN(buffer, length, parser, message->httpType);
+}
+
+static void benchParseHttpBufferNWithHeaders(const HTTPBenchMessage *message, char *buffer, size_t length, HTTPParser *parser) {
+    parseHttpBufferN(buffer, length, parser, message->httpType);
+    parseHttpHeadersN(parser, buffer, length);
+}
+
+static const BenchCase BENCH_CASES[] = {
+        {"parseHttpBuffer",            benchParseHttpBuffer},
+        {"parseHttpBuffer+Headers",    benchParseHttpBufferWithHeaders},
+        {"parseHttpQueryParameters",   benchParseHttpQueryParameters},
+        {"parseHttpMessage",           benchParseHttpMessage},
+        {"parseHttpBufferN",           benchParseHttpBufferN},
+        {"parseHttpBufferN+HeadersN",  benchParseHttpBufferNWithHeaders},
+};
+
+static const BenchProfile BENCH_PROFILES[] = {    // first one is baseline of speedup column
+        {"strict",  HTTP_VALIDATION_STRICT},
+        {"lenient", HTTP_VALIDATION_LENIENT},
+        {"trusted", HTTP_VALIDATION_TRUSTED},
+};
+
+static inline uint64_t getNanoTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t) time.tv_sec * NANOSECONDS_IN_SECOND + time.tv_nsec;
+}
+
+static int compareLatency(const void *first, const void *second) {
+    uint32_t a = *(const uint32_t *) first;
+    uint32_t b = *(const uint32_t *) second;
+    return (a > b) - (a < b);
+}
+
+static uint32_t getPercentile(const uint32_t *sortedLatencies, size_t count, double percentile) {
+    size_t index = (size_t) (percentile / 100.0 * (double) (count - 1));
+    return sortedLatencies[index];
+}
+
+static double runBenchCase(const BenchCase *benchCase, const BenchProfile *profile, uint32_t iterations, uint32_t *latencies,
+                           HTTPParser *parser, bool isReported, double baselineRate) {   // messages per second, 0 baseline is own rate
+    static char buffer[MESSAGE_BUFFER_SIZE];
+    size_t sampleCount = 0;
+    size_t totalBytes = 0;
+#if defined(HTTP_BENCH_COUNT_ALLOCATIONS)
+    size_t allocations = 0;
+#endif
+    uint64_t totalTime = 0;
+    parser->validationChecks = profile->validationChecks;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (uint32_t j = 0; j < ARRAY_SIZE(HTTP_BENCH_CORPUS); j++) {
+            const HTTPBenchMessage *message = &HTTP_BENCH_CORPUS[j];
+            size_t length = strlen(message->data);
+            memcpy(buffer, message->data, length + 1);  // old API spoils buffer, copy is not timed
+
+#if defined(HTTP_BENCH_COUNT_ALLOCATIONS)
+            size_t allocationsBefore = allocationCount;
+#endif
+            uint64_t start = getNanoTime();
+            benchCase->run(message, buffer, length, parser);
+            uint64_t elapsed = getNanoTime() - start;
+#if defined(HTTP_BENCH_COUNT_ALLOCATIONS)
+            allocations += allocationCount - allocationsBefore;
+#endif
+            latencies[sampleCount++] = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t) elapsed;
+            totalTime += elapsed;
+            totalBytes += length;
+        }
+    }
+
+    double seconds = (double) totalTime / NANOSECONDS_IN_SECOND;
+    double rate = (double) sampleCount / seconds;
+    if (!isReported) return rate;
+
+    qsort(latencies, sampleCount, sizeof(uint32_t), compareLatency);
+    printf("%-28s %-8s %10.1f %12.0f %8u %8u %8u %9u %7.2fx",
+           benchCase->name,
+           profile->name,
+           (double) totalBytes / seconds / (1024.0 * 1024.0),
+           rate,
+           getPercentile(latencies, sampleCount, 50.0),
+           getPercentile(latencies, sampleCount, 90.0),
+           getPercentile(latencies, sampleCount, 99.0),
+           getPercentile(latencies, sampleCount, 99.9),
+           baselineRate > 0 ? rate / baselineRate : 1.0);
+#if defined(HTTP_BENCH_COUNT_ALLOCATIONS)
+    printf(" %11.2f\n", (double) allocations / (double) sampleCount);
+#else
+    printf(" %11s\n", "n/a");
+#endif
+    return rate;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t iterations = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : DEFAULT_ITERATIONS;
+    iterations = iterations > 0 ? iterations : DEFAULT_ITERATIONS;
+
+    uint32_t *latencies = malloc(sizeof(uint32_t) * iterations * ARRAY_SIZE(HTTP_BENCH_CORPUS));
+    HTTPParser *parser = getHttpParserInstance();
+    if (latencies == NULL || parser == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    static const char *const SCAN_IMPLEMENTATION_NAMES[] = {"auto", "scalar", "sse4.2", "avx2"};
+    printf("Corpus: %u messages, %u iterations, scan: %s\n",
+           (uint32_t) ARRAY_SIZE(HTTP_BENCH_CORPUS), iterations, SCAN_IMPLEMENTATION_NAMES[getHttpScanImplementation()]);
+    printf("%-28s %-8s %10s %12s %8s %8s %8s %9s %8s %11s\n",
+           "function", "profile", "MB/s", "msg/s", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "speedup", "allocs/msg");
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(BENCH_CASES); i++) {
+        runBenchCase(&BENCH_CASES[i], &BENCH_PROFILES[0], 1, latencies, parser, false, 0);    // warm up caches and lazy maps
+    }
+    for (uint32_t i = 0; i < ARRAY_SIZE(BENCH_CASES); i++) {
+        double baselineRate = runBenchCase(&BENCH_CASES[i], &BENCH_PROFILES[0], iterations, latencies, parser, true, 0);
+        for (uint32_t j = 1; j < ARRAY_SIZE(BENCH_PROFILES); j++) {
+            runBenchCase(&BENCH_CASES[i], &BENCH_PROFILES[j], iterations, latencies, parser, true, baselineRate);
+        }
+    }
+
+    deleteHttpParser(parser);
+    free(latencies);
+    return EXIT_SUCCESS;
+}
@@ -1,19 +1,295 @@
 #include "HTTPParser.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HTTP_PARSER_X86_DISPATCH    // SIMD kernels are compiled with target attributes and selected at runtime
+#include <immintrin.h>
+#endif
+
 #define HTTP_STATUS_LENGTH 3
 #define HTTP_STATUS_CODE_MAX_VALUE 511
 #define HTTP_METHOD_MAX_LENGTH 7
 #define HTTP_CONSTANT_NAME_WITH_SLASH "HTTP/"
-#define TRANSFER_ENCODING_HEADER_NAME "Transfer-Encoding: "
-#define CONTENT_TYPE_HEADER_NAME "Content-Length: "
-#define CONTENT_LENGTH_VALUE_BUFFER_SIZE 20
+#define TRANSFER_ENCODING_HEADER_NAME "Transfer-Encoding"
+#define CONTENT_LENGTH_HEADER_NAME "Content-Length"
 #define HTTP_HEADERS_END_DELIMITER_LENGTH 5
 #define HTTP_HEADERS_MAP_INITIAL_CAPACITY 16
 #define HTTP_QUERY_PARAM_MAP_INITIAL_CAPACITY 8
+#define HTTP_UNKNOWN_HEADERS_INITIAL_CAPACITY 8
+#define HTTP_HEADER_ID_HASH_MASK 0x7F
 #define HTTP_URI_ROOT_PATH_START "/"
 #define HTTP_STATUS_CODE_MESSAGE_MAX_LENGTH 50
+#define HTTP_CONSTANT_NAME_LENGTH 5
+#define HTTP_VERSION_CHAR_COUNT 3
+#define HTTP_STATUS_LINE_OK "HTTP/1.1 200 "     // most frequent response start, compared as two overlapping words
+#define HTTP_STATUS_LINE_OK_LENGTH 13
+#define HTTP_STATUS_LINE_START "HTTP/1.1 "
+#define HTTP_REQUEST_LINE_END " HTTP/1.1\r\n"
+#define HTTP_HEADER_NAME_SEPARATOR ": "
+#define HTTP_CRLF "\r\n"
+#define HTTP_CONTENT_LENGTH_LINE_START "Content-Length: "
+#define HTTP_STATIC_VECTOR(text) (text), sizeof(text) - 1
+
+#define HTTP_HEADER_TYPE_NONE 0
+#define HTTP_HEADER_TYPE_CONTENT_LENGTH 1
+#define HTTP_HEADER_TYPE_TRANSFER_ENCODING 2
+#define HTTP_SCANNED_HEADER_COUNT 2
+#define HTTP_HEADER_TYPE_BIT(headerType) (1 << ((headerType) - 1))
+#define HTTP_CONTENT_LENGTH_EMPTY 0
+#define HTTP_CONTENT_LENGTH_DIGITS 1
+#define HTTP_CONTENT_LENGTH_ENDED 2     // only spaces may follow
+#define HTTP_EIGHT_DIGITS_FACTOR 100000000ULL
+#define HTTP_CHUNKED_CODING_NAME "chunked"
+#define HTTP_CHUNKED_CODING_LENGTH 7
+#define HTTP_CHUNKED_CODING_NONE 0
+#define HTTP_CHUNKED_CODING_FINAL 1
+#define HTTP_CHUNKED_CODING_NOT_FINAL 2    // followed by other coding or applied twice
+#define HTTP_TRANSFER_CODING_SEPARATOR ", "
+
+#define HTTP_CHAR_CTL 0x01           // 0x00-0x1F, DEL
+#define HTTP_CHAR_WHITESPACE 0x02    // isspace() in "C" locale
+#define HTTP_CHAR_DIGIT 0x04
+#define HTTP_CHAR_TCHAR 0x08         // token char, RFC 9110 5.6.2
+#define HTTP_CHAR_VCHAR 0x10         // visible ASCII
+#define HTTP_CHAR_OBS_TEXT 0x20      // 0x80-0xFF
+#define HTTP_CHAR_SP_HTAB 0x40
+#define HTTP_CHAR_HEXDIG 0x80
+#define HTTP_CHAR_TOKEN (HTTP_CHAR_VCHAR | HTTP_CHAR_TCHAR)
+#define HTTP_CHAR_FIELD_VALUE (HTTP_CHAR_VCHAR | HTTP_CHAR_OBS_TEXT | HTTP_CHAR_SP_HTAB)
+
+#define IS_HTTP_CHAR_CLASS(ch, charClass) ((HTTP_CHAR_CLASSES[(uint8_t) (ch)] & (charClass)) != 0)
+#define IS_HTTP_CTL(ch) IS_HTTP_CHAR_CLASS(ch, HTTP_CHAR_CTL)
+#define IS_HTTP_CHECK_ENABLED(httpParser, check) (((HTTP_VALIDATION_PROFILE) & (check)) && ((httpParser)->validationChecks & (check)))    // folded away when profile drops check
+#define IS_HTTP_WHITESPACE(ch) IS_HTTP_CHAR_CLASS(ch, HTTP_CHAR_WHITESPACE)
+#define IS_HTTP_DIGIT(ch) IS_HTTP_CHAR_CLASS(ch, HTTP_CHAR_DIGIT)
+#define IS_HTTP_HEXDIG(ch) IS_HTTP_CHAR_CLASS(ch, HTTP_CHAR_HEXDIG)
+#define HTTP_HEXDIG_VALUE(ch) (IS_HTTP_DIGIT(ch) ? (ch) - '0' : ((ch) | 0x20) - 'a' + 10)
+#define HTTP_CHUNK_SIZE_MAX_BEFORE_DIGIT (UINT64_MAX >> 4)
+#define IS_SPACE_OR_TAB(ch) ((ch) == ' ' || (ch) == '\t')
+#define IS_LINE_END(ch) ((ch) == '\r' || (ch) == '\n')
+#define HTTP_BATCH_PREFETCH_DISTANCE 2     // messages ahead, covers memory latency of one small message parse
+#define HTTP_CACHE_LINE_SIZE 64
+#define HTTP_ARENA_ALIGNMENT 16
+#if defined(__GNUC__)
+#define HTTP_PREFETCH_READ(address) __builtin_prefetch((address), 0, 3)
+#define HTTP_PREFETCH_WRITE(address) __builtin_prefetch((address), 1, 3)
+#else
+#define HTTP_PREFETCH_READ(address) ((void) (address))
+#define HTTP_PREFETCH_WRITE(address) ((void) (address))
+#endif
+#define HTTP_FORCE_SCALAR_ENV_NAME "HTTP_PARSER_FORCE_SCALAR"
+#define HTTP_HEADER_ID_HASH_CHAR(ch) ((uint8_t) ((ch) | 0x20))     // ASCII letters case folded
+#define HTTP_ASCII_LOWER(ch) ((ch) >= 'A' && (ch) <= 'Z' ? (ch) | 0x20 : (ch))
+#define HTTP_WORD_REPEAT_BYTE(byte) (0x0101010101010101ULL * (byte))
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define HTTP_WORD_TO_LITTLE_ENDIAN(word) __builtin_bswap64(word)
+#else
+#define HTTP_WORD_TO_LITTLE_ENDIAN(word) (word)
+#endif
+#define HTTP_HEADER_INDEX_SIZE(httpParser) ((httpParser)->headerCount < HTTP_HEADER_INDEX_CAPACITY ? (httpParser)->headerCount : HTTP_HEADER_INDEX_CAPACITY)
 
 static const char *const HTTP_SUPPORTED_VERSIONS_ARRAY[] = {"1.0", "1.1"};
+static const uint8_t HTTP_CHAR_CLASSES[256] = {     // one load and mask per byte check, locale independent
+        [0x00 ... 0x08] = HTTP_CHAR_CTL,
+        ['\t'] = HTTP_CHAR_CTL | HTTP_CHAR_WHITESPACE | HTTP_CHAR_SP_HTAB,
+        ['\n' ... '\r'] = HTTP_CHAR_CTL | HTTP_CHAR_WHITESPACE,
+        [0x0E ... 0x1F] = HTTP_CHAR_CTL,
+        [' '] = HTTP_CHAR_WHITESPACE | HTTP_CHAR_SP_HTAB,
+        ['!'] = HTTP_CHAR_TOKEN,
+        ['"'] = HTTP_CHAR_VCHAR,
+        ['#' ... '\''] = HTTP_CHAR_TOKEN,
+        ['(' ... ')'] = HTTP_CHAR_VCHAR,
+        ['*' ... '+'] = HTTP_CHAR_TOKEN,
+        [','] = HTTP_CHAR_VCHAR,
+        ['-' ... '.'] = HTTP_CHAR_TOKEN,
+        ['/'] = HTTP_CHAR_VCHAR,
+        ['0' ... '9'] = HTTP_CHAR_TOKEN | HTTP_CHAR_DIGIT | HTTP_CHAR_HEXDIG,
+        [':' ... '@'] = HTTP_CHAR_VCHAR,
+        ['A' ... 'F'] = HTTP_CHAR_TOKEN | HTTP_CHAR_HEXDIG,
+        ['G' ... 'Z'] = HTTP_CHAR_TOKEN,
+        ['[' ... ']'] = HTTP_CHAR_VCHAR,
+        ['^' ... '`'] = HTTP_CHAR_TOKEN,
+        ['a' ... 'f'] = HTTP_CHAR_TOKEN | HTTP_CHAR_HEXDIG,
+        ['g' ... 'z'] = HTTP_CHAR_TOKEN,
+        ['{'] = HTTP_CHAR_VCHAR,
+        ['|'] = HTTP_CHAR_TOKEN,
+        ['}'] = HTTP_CHAR_VCHAR,
+        ['~'] = HTTP_CHAR_TOKEN,
+        [0x7F] = HTTP_CHAR_CTL,
+        [0x80 ... 0xFF] = HTTP_CHAR_OBS_TEXT
+};
+
+static const char *const HTTP_SCANNED_HEADER_NAMES[HTTP_SCANNED_HEADER_COUNT] = {"content-length", "transfer-encoding"};   // lower case, compared with folded input
+
+// Perfect hash of known header names: (length + value of first char + value of last char) & 0x7F.
+// Values are picked so that every name in HTTP_HEADER_ID_NAMES has its own slot, lookup verifies the name.
+static const uint8_t HTTP_HEADER_ID_HASH_VALUES[256] = {
+        ['a'] = 96, ['c'] = 60, ['d'] = 58, ['e'] = 22, ['f'] = 56, ['g'] = 32, ['h'] = 65, ['i'] = 4, ['k'] = 36,
+        ['l'] = 41, ['m'] = 125, ['n'] = 23, ['o'] = 34, ['p'] = 55, ['r'] = 24, ['s'] = 35, ['t'] = 118, ['u'] = 33, ['v'] = 10, ['w'] = 118, ['x'] = 101, ['y'] = 60
+};
+
+static const uint8_t HTTP_HEADER_ID_HASH_SLOTS[HTTP_HEADER_ID_HASH_MASK + 1] = {
+        [4] = HTTP_HEADER_ID_AUTHORIZATION,
+        [5] = HTTP_HEADER_ID_ACCEPT_LANGUAGE,
+        [11] = HTTP_HEADER_ID_CONTENT_LENGTH,
+        [12] = HTTP_HEADER_ID_X_FORWARDED_FOR,
+        [14] = HTTP_HEADER_ID_TE,
+        [15] = HTTP_HEADER_ID_ACCEPT_ENCODING,
+        [16] = HTTP_HEADER_ID_ACCEPT_RANGES,
+        [18] = HTTP_HEADER_ID_EXPECT,
+        [21] = HTTP_HEADER_ID_TRAILER,
+        [28] = HTTP_HEADER_ID_WWW_AUTHENTICATE,
+        [29] = HTTP_HEADER_ID_PRAGMA,
+        [33] = HTTP_HEADER_ID_USER_AGENT,
+        [34] = HTTP_HEADER_ID_IF_RANGE,
+        [39] = HTTP_HEADER_ID_TRANSFER_ENCODING,
+        [43] = HTTP_HEADER_ID_IF_MODIFIED_SINCE,
+        [45] = HTTP_HEADER_ID_IF_UNMODIFIED_SINCE,
+        [51] = HTTP_HEADER_ID_RANGE,
+        [55] = HTTP_HEADER_ID_REFERER,
+        [57] = HTTP_HEADER_ID_FROM,
+        [58] = HTTP_HEADER_ID_ETAG,
+        [59] = HTTP_HEADER_ID_HOST,
+        [62] = HTTP_HEADER_ID_UPGRADE,
+        [63] = HTTP_HEADER_ID_ORIGIN,
+        [64] = HTTP_HEADER_ID_EXPIRES,
+        [65] = HTTP_HEADER_ID_SERVER,
+        [67] = HTTP_HEADER_ID_SET_COOKIE,
+        [68] = HTTP_HEADER_ID_KEEP_ALIVE,
+        [72] = HTTP_HEADER_ID_LOCATION,
+        [74] = HTTP_HEADER_ID_VARY,
+        [77] = HTTP_HEADER_ID_IF_MATCH,
+        [82] = HTTP_HEADER_ID_IF_NONE_MATCH,
+        [84] = HTTP_HEADER_ID_DATE,
+        [88] = HTTP_HEADER_ID_COOKIE,
+        [91] = HTTP_HEADER_ID_ALLOW,
+        [92] = HTTP_HEADER_ID_ACCEPT,
+        [93] = HTTP_HEADER_ID_CONNECTION,
+        [94] = HTTP_HEADER_ID_CONTENT_TYPE,
+        [95] = HTTP_HEADER_ID_CONTENT_RANGE,
+        [97] = HTTP_HEADER_ID_PROXY_AUTHORIZATION,
+        [98] = HTTP_HEADER_ID_CONTENT_LANGUAGE,
+        [99] = HTTP_HEADER_ID_CONTENT_LOCATION,
+        [100] = HTTP_HEADER_ID_ACCEPT_CHARSET,
+        [102] = HTTP_HEADER_ID_CONTENT_DISPOSITION,
+        [108] = HTTP_HEADER_ID_CONTENT_ENCODING,
+        [109] = HTTP_HEADER_ID_VIA,
+        [112] = HTTP_HEADER_ID_LAST_MODIFIED,
+        [114] = HTTP_HEADER_ID_CACHE_CONTROL,
+        [121] = HTTP_HEADER_ID_AGE,
+        [123] = HTTP_HEADER_ID_FORWARDED,
+};
+
+static const char *const HTTP_HEADER_ID_NAMES[HTTP_HEADER_ID_COUNT] = {
+        [HTTP_HEADER_ID_ACCEPT] = "Accept",
+        [HTTP_HEADER_ID_ACCEPT_CHARSET] = "Accept-Charset",
+        [HTTP_HEADER_ID_ACCEPT_ENCODING] = "Accept-Encoding",
+        [HTTP_HEADER_ID_ACCEPT_LANGUAGE] = "Accept-Language",
+        [HTTP_HEADER_ID_ACCEPT_RANGES] = "Accept-Ranges",
+        [HTTP_HEADER_ID_AGE] = "Age",
+        [HTTP_HEADER_ID_ALLOW] = "Allow",
+        [HTTP_HEADER_ID_AUTHORIZATION] = "Authorization",
+        [HTTP_HEADER_ID_CACHE_CONTROL] = "Cache-Control",
+        [HTTP_HEADER_ID_CONNECTION] = "Connection",
+        [HTTP_HEADER_ID_CONTENT_DISPOSITION] = "Content-Disposition",
+        [HTTP_HEADER_ID_CONTENT_ENCODING] = "Content-Encoding",
+        [HTTP_HEADER_ID_CONTENT_LANGUAGE] = "Content-Language",
+        [HTTP_HEADER_ID_CONTENT_LENGTH] = "Content-Length",
+        [HTTP_HEADER_ID_CONTENT_LOCATION] = "Content-Location",
+        [HTTP_HEADER_ID_CONTENT_RANGE] = "Content-Range",
+        [HTTP_HEADER_ID_CONTENT_TYPE] = "Content-Type",
+        [HTTP_HEADER_ID_COOKIE] = "Cookie",
+        [HTTP_HEADER_ID_DATE] = "Date",
+        [HTTP_HEADER_ID_ETAG] = "ETag",
+        [HTTP_HEADER_ID_EXPECT] = "Expect",
+        [HTTP_HEADER_ID_EXPIRES] = "Expires",
+        [HTTP_HEADER_ID_FORWARDED] = "Forwarded",
+        [HTTP_HEADER_ID_FROM] = "From",
+        [HTTP_HEADER_ID_HOST] = "Host",
+        [HTTP_HEADER_ID_IF_MATCH] = "If-Match",
+        [HTTP_HEADER_ID_IF_MODIFIED_SINCE] = "If-Modified-Since",
+        [HTTP_HEADER_ID_IF_NONE_MATCH] = "If-None-Match",
+        [HTTP_HEADER_ID_IF_RANGE] = "If-Range",
+        [HTTP_HEADER_ID_IF_UNMODIFIED_SINCE] = "If-Unmodified-Since",
+        [HTTP_HEADER_ID_KEEP_ALIVE] = "Keep-Alive",
+        [HTTP_HEADER_ID_LAST_MODIFIED] = "Last-Modified",
+        [HTTP_HEADER_ID_LOCATION] = "Location",
+        [HTTP_HEADER_ID_ORIGIN] = "Origin",
+        [HTTP_HEADER_ID_PRAGMA] = "Pragma",
+        [HTTP_HEADER_ID_PROXY_AUTHORIZATION] = "Proxy-Authorization",
+        [HTTP_HEADER_ID_RANGE] = "Range",
+        [HTTP_HEADER_ID_REFERER] = "Referer",
+        [HTTP_HEADER_ID_SERVER] = "Server",
+        [HTTP_HEADER_ID_SET_COOKIE] = "Set-Cookie",
+        [HTTP_HEADER_ID_TE] = "TE",
+        [HTTP_HEADER_ID_TRAILER] = "Trailer",
+        [HTTP_HEADER_ID_TRANSFER_ENCODING] = "Transfer-Encoding",
+        [HTTP_HEADER_ID_UPGRADE] = "Upgrade",
+        [HTTP_HEADER_ID_USER_AGENT] = "User-Agent",
+        [HTTP_HEADER_ID_VARY] = "Vary",
+        [HTTP_HEADER_ID_VIA] = "Via",
+        [HTTP_HEADER_ID_WWW_AUTHENTICATE] = "WWW-Authenticate",
+        [HTTP_HEADER_ID_X_FORWARDED_FOR] = "X-Forwarded-For",
+};
+
+typedef struct HTTPMethodWord {     // method name with trailing space, compared as one 64-bit word
+    char word[8];
+    char mask[8];
+    HTTPMethod method;
+    uint8_t length;
+} HTTPMethodWord;
+
+static const HTTPMethodWord HTTP_METHOD_WORDS[] = {     // most frequent first
+        {"GET ", "\xff\xff\xff\xff", HTTP_GET, 4},
+        {"POST ", "\xff\xff\xff\xff\xff", HTTP_POST, 5},
+        {"PUT ", "\xff\xff\xff\xff", HTTP_PUT, 4},
+        {"DELETE ", "\xff\xff\xff\xff\xff\xff\xff", HTTP_DELETE, 7},
+        {"HEAD ", "\xff\xff\xff\xff\xff", HTTP_HEAD, 5},
+        {"OPTIONS ", "\xff\xff\xff\xff\xff\xff\xff\xff", HTTP_OPTIONS, 8},
+        {"PATCH ", "\xff\xff\xff\xff\xff\xff", HTTP_PATCH, 6},
+        {"CONNECT ", "\xff\xff\xff\xff\xff\xff\xff\xff", HTTP_CONNECT, 8},
+        {"TRACE ", "\xff\xff\xff\xff\xff\xff", HTTP_TRACE, 6}
+};
+
+typedef struct HTTPStatusLine {     // whole status line, serialized as one vector
+    HTTPStatus statusCode;
+    const char *line;
+    uint8_t length;
+} HTTPStatusLine;
+
+#define HTTP_STATUS_LINE(statusCode, line) {statusCode, line, sizeof(line) - 1}
+
+static const HTTPStatusLine HTTP_STATUS_LINES[] = {     // most frequent first, others are built from code and meaning
+        HTTP_STATUS_LINE(HTTP_OK, "HTTP/1.1 200 OK\r\n"),
+        HTTP_STATUS_LINE(HTTP_NOT_FOUND, "HTTP/1.1 404 Not Found\r\n"),
+        HTTP_STATUS_LINE(HTTP_NO_CONTENT, "HTTP/1.1 204 No Content\r\n"),
+        HTTP_STATUS_LINE(HTTP_NOT_MODIFIED, "HTTP/1.1 304 Not Modified\r\n"),
+        HTTP_STATUS_LINE(HTTP_CREATED, "HTTP/1.1 201 Created\r\n"),
+        HTTP_STATUS_LINE(HTTP_MOVED_PERMANENTLY, "HTTP/1.1 301 Moved Permanently\r\n"),
+        HTTP_STATUS_LINE(HTTP_BAD_REQUEST, "HTTP/1.1 400 Bad Request\r\n"),
+        HTTP_STATUS_LINE(HTTP_INTERNAL_SERVER_ERROR, "HTTP/1.1 500 Internal Server Error\r\n"),
+        HTTP_STATUS_LINE(HTTP_SERVICE_UNAVAILABLE, "HTTP/1.1 503 Service Unavailable\r\n")
+};
+
+typedef struct HTTPCharRanges {     // inclusive byte ranges, padded to one SSE register
+    char ranges[16];
+    uint8_t length;
+} HTTPCharRanges;
+
+static const HTTPCharRanges HTTP_URI_PATH_STOP_CHARS = {"\000\040##??\177\177", 8};      // CTL, SP, '#', '?'
+static const HTTPCharRanges HTTP_URI_QUERY_STOP_CHARS = {"\000\040##\177\177", 6};        // CTL, SP, '#'
+static const HTTPCharRanges HTTP_URI_FRAGMENT_STOP_CHARS = {"\000\040\177\177", 4};        // CTL, SP
+static const HTTPCharRanges HTTP_HEADER_NAME_STOP_CHARS = {"\000\040::\177\177", 6};       // CTL, SP, ':'
+static const HTTPCharRanges HTTP_HEADER_VALUE_STOP_CHARS = {"\000\010\012\037\177\177", 6}; // CTL except HTAB
+static const HTTPCharRanges HTTP_LINE_END_CHARS = {"\n\n\r\r", 4};
+static const HTTPCharRanges HTTP_QUERY_ESCAPE_CHARS = {"%%++", 4};
+static const HTTPCharRanges HTTP_PATH_ESCAPE_CHARS = {"%%//", 4};
+
+typedef const char *(*HTTPCharRangesFinder)(const char *pointer, const char *end, const HTTPCharRanges *charRanges);
+static const char *findHttpCharRangesScalar(const char *pointer, const char *end, const HTTPCharRanges *charRanges);
+
+// Written only before main() by resolveHttpScanImplementation() or by setHttpScanImplementation(), read without locks
+static HTTPCharRangesFinder findHttpCharRanges = findHttpCharRangesScalar;
+static HTTPScanImplementation httpScanImplementation = HTTP_SCAN_SCALAR;
 
 static void parseHttpVersion(const char *dataBuffer, HTTPParser *httpParser);
 static void parseHttpContentLength(const char *dataBuffer, HTTPParser *httpParser);
@@ -24,15 +300,104 @@ static void parseHttpTransferEncoding(const char *dataBuffer, HTTPParser *httpPa
 static void parseHttpMessageBody(const char *dataBuffer, HTTPParser *httpParser);
 static bool isMessageBodyNeedToBeSkipped(HTTPParser *httpParser);
 static inline char *resolveHttpLineSeparator(const char *dataBuffer);
-static bool isHttpHeaderKeyValid(const char *headerKey);
-static bool isHttpHeaderValueValid(const char *headerValue);
+static bool isHttpHeaderKeyValid(const char *headerKey, size_t length);
+static bool isHttpHeaderValueValid(const char *headerValue, size_t length);
+static bool isHttpHeaderValid(const HTTPParser *httpParser, const char *headerKey, size_t keyLength, const char *headerValue, size_t valueLength);
+static bool isHttpRequestTargetValid(const char *target, size_t length);
+static bool isHttpVersionSupported(const char *httpVersion);
+static size_t executeHttpParser(HTTPParser *httpParser, const char *data, size_t length);
+static void onHttpLineEnd(HTTPParser *httpParser, char ch, uint32_t offset);
+static void onHttpRequestTargetChar(HTTPParser *httpParser, char ch, uint32_t offset);
+static void onHttpRequestTargetPartEnd(HTTPParser *httpParser, char ch, uint32_t offset);
+static const char *getHttpRequestTargetScanEnd(const HTTPParser *httpParser, const char *data, const char *pointer, const char *end);
+static const char *getHttpHeadersScanEnd(const HTTPParser *httpParser, const char *data, const char *pointer, const char *end);
+static void checkHttpHeaderLimits(HTTPParser *httpParser, char ch, uint32_t offset);
+static void onHttpHeaderNameChar(HTTPParserScanState *scan, char ch);
+static void onHttpHeaderNameEnd(HTTPParser *httpParser, uint32_t offset);
+static HTTPHeaderSpan *getCurrentHttpHeaderSpan(HTTPParser *httpParser);
+static void onHttpHeaderValueChar(HTTPParser *httpParser, char ch);
+static void onHttpContentLengthChar(HTTPParser *httpParser, char ch);
+static const char *skipHttpContentLengthDigits(HTTPParser *httpParser, const char *data, const char *pointer, const char *end);
+static bool parseHttpContentLengthValue(const char *value, size_t length, uint64_t *contentLength);
+static bool isHttpStatusMessageCharMatch(HTTPParserScanState *scan, char ch);
+static bool isHttpStatusCodeValid(uint32_t statusCode);
+static void onHttpStatusCodeEnd(HTTPParser *httpParser);
+static bool isHttpStatusLineOk(const char *pointer);
+static bool appendHttpVector(HTTPSerializer *serializer, const char *data, size_t length);
+static bool appendHttpStatusLine(HTTPSerializer *serializer, HTTPStatus statusCode);
+static bool appendHttpHeadersAndBody(HTTPSerializer *serializer, const HTTPOutputHeader *headers, uint16_t headerCount,
+                                     const HTTPBodySegment *body, uint16_t bodyCount);
+static uint16_t completeHttpSerializer(HTTPSerializer *serializer, bool isComplete);
+static void onHttpMessageHeadComplete(HTTPParser *httpParser);
+static uint8_t findHttpChunkedCoding(const char *codings);
+static HTTPParserStatus checkHttpTransferEncoding(const HTTPParser *httpParser, bool hasContentLength);
+static bool appendHttpTransferCodings(HTTPParser *httpParser, size_t *length, const char *value, size_t valueLength);
+static bool isHttpDataBlank(const char *data, size_t length);
+static char *reserveHttpParserStorage(HTTPParser *httpParser, HTTPParserStorage *storage, size_t size);
+static void *allocateHttpHeap(void *context, size_t size);
+static void *reallocateHttpHeap(void *context, void *pointer, size_t oldSize, size_t newSize);
+static void releaseHttpHeap(void *context, void *pointer, size_t size);
+static void *allocateHttpArena(void *context, size_t size);
+static void *reallocateHttpArena(void *context, void *pointer, size_t oldSize, size_t newSize);
+static char *copyToHttpParserStorage(char *storagePointer, const char *data, size_t length);
+static void trimHttpSpan(const char **start, const char **end);
+static HTTPHeaderSpan findHttpHeaderBefore(HTTPParser *httpParser, const char *messageBuffer, const char *dataEnd, const char *name);
+static const char *findHttpHeaderLine(const char *messageBuffer, const char *line, const char *end, const char *name, HTTPHeaderSpan *headerSpan);
+static bool isHttpHeaderLineMalformed(const char *line, const char *end, const HTTPHeaderSpan *headerSpan);
+static const char *skipHttpPlainChars(HTTPParser *httpParser, const char *data, const char *pointer, const char *end);
+static bool isHttpScanImplementationSupported(HTTPScanImplementation implementation);
+static const HTTPMethodWord *matchHttpMethodWord(const char *pointer);
+#if defined(HTTP_PARSER_X86_DISPATCH)
+static void resolveHttpScanImplementation(void) __attribute__((constructor));
+static const char *findHttpCharRangesSse42(const char *pointer, const char *end, const HTTPCharRanges *charRanges);
+static const char *findHttpCharRangesAvx2(const char *pointer, const char *end, const HTTPCharRanges *charRanges);
+#endif
+static char *putHttpHeaderCopy(HTTPParser *httpParser, char *storagePointer, const char *key, size_t keyLength, const char *value, size_t valueLength);
+static void clearHttpHeaders(HTTPParser *httpParser);
+static bool isHttpParserMapAvailable(HTTPParser *httpParser);
+static void clearHttpParserStrings(HTTPParser *httpParser);
+static void clearHttpKnownHeaders(HTTPParser *httpParser);
+static const char *nextHttpChunkedRun(HTTPChunkedDecoder *decoder, const char **pointer, const char *end, size_t *runLength);
+static void onHttpChunkedFramingChar(HTTPChunkedDecoder *decoder, char ch);
+static HTTPParserStatus getHttpChunkedStatus(const HTTPChunkedDecoder *decoder);
+static HTTPParserStatus frameHttpMessageBody(HTTPParser *httpParser, const char *data, size_t length);
+static void prefetchHttpBatchMessage(const char *data, size_t length, HTTPParser *httpParser);
+static void putHttpHeader(HTTPParser *httpParser, char *key, size_t keyLength, char *value);
+static bool isHttpNameEqualIgnoreCase(const char *name, const char *otherName, size_t length);
+static bool decodeHttpPercentEscape(const char *pointer, const char *end, char *decoded);
+static char *removeHttpDotSegment(char *buffer, char *segmentStart, char *segmentEnd);
+
+static const HTTPParserAllocator HTTP_HEAP_ALLOCATOR = {allocateHttpHeap, reallocateHttpHeap, releaseHttpHeap, NULL};
 
 
 HTTPParser *getHttpParserInstance() {
-    HTTPParser *httpParser = malloc(sizeof(struct HTTPParser));
+    return getHttpParserInstanceWithAllocator(NULL);
+}
+
+HTTPParser *getHttpParserInstanceWithAllocator(const HTTPParserAllocator *allocator) {
+    allocator = allocator != NULL ? allocator : &HTTP_HEAP_ALLOCATOR;
+    HTTPParser *httpParser = allocator->allocate(allocator->context, sizeof(struct HTTPParser));
     if (httpParser != NULL) {
+        httpParser->allocator = *allocator;
+        httpParser->pool = NULL;
+        httpParser->isPooled = false;
         httpParser->headers = NULL;
         httpParser->queryParameters = NULL;
+        httpParser->headersStorage = (HTTPParserStorage) {0};
+        httpParser->queryParametersStorage = (HTTPParserStorage) {0};
+        memset(httpParser->knownHeaders, 0, sizeof(httpParser->knownHeaders));
+        httpParser->knownHeadersMask = 0;
+        memset(httpParser->httpVersion, 0, HTTP_VERSION_LENGTH);    // later resets clear only written prefix
+        httpParser->requestTarget = (HTTPRequestTarget) {0};
+        httpParser->maxRequestTargetLength = HTTP_REQUEST_TARGET_MAX_LENGTH;
+        httpParser->validationChecks = HTTP_VALIDATION_PROFILE;
+        httpParser->maxHeaderCount = HTTP_HEADER_MAX_COUNT;
+        httpParser->maxHeaderLineLength = HTTP_HEADER_LINE_MAX_LENGTH;
+        httpParser->maxHeadersLength = HTTP_HEADERS_MAX_LENGTH;
+        memset(httpParser->transferEncodingTypes, 0, HTTP_TRANSFER_ENCODING_TYPES_LENGTH);
+        httpParser->unknownHeaders = NULL;
+        httpParser->unknownHeaderCount = 0;
+        httpParser->unknownHeaderCapacity = 0;
     }
     return httpParser;
 }
@@ -44,10 +409,13 @@ void parseHttpBuffer(char *httpDataBuffer, HTTPParser *httpParser, HTTPParserTyp
     httpParser->messageBody = NULL;
     httpParser->httpType = httpType;
     httpParser->parserStatus = HTTP_PARSE_OK;
+    httpParser->headersStartOffset = 0;     // header block bounds are found lazily by httpFindHeader()
+    httpParser->headersEndOffset = 0;
+    httpParser->headerCount = 0;    // header index is filled only by single-pass engine
+    httpParser->requestTarget = (HTTPRequestTarget) {0};
+    resetHttpChunkedDecoder(&httpParser->chunkedDecoder);
 
-    memset(httpParser->httpVersion, 0, HTTP_VERSION_LENGTH);
-    memset(httpParser->uriPath, 0, HTTP_REQUEST_URI_PATH_LENGTH);
-    memset(httpParser->transferEncodingTypes, 0, HTTP_TRANSFER_ENCODING_TYPES_LENGTH);
+    clearHttpParserStrings(httpParser);
 
     if (isStringBlank(httpDataBuffer)) {
         httpParser->parserStatus = HTTP_PARSE_ERROR_EMPTY_DATA;
@@ -69,10 +437,70 @@ void parseHttpBuffer(char *httpDataBuffer, HTTPParser *httpParser, HTTPParserTyp
     parseHttpMessageBody(httpDataBuffer, httpParser);
 }
 
+void parseHttpMessage(const char *httpDataBuffer, HTTPParser *httpParser, HTTPParserType httpType) {
+    resetHttpParser(httpParser, httpType);
+    if (isStringBlank(httpDataBuffer)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_EMPTY_DATA;
+        return;
+    }
+
+    executeHttpParser(httpParser, httpDataBuffer, strlen(httpDataBuffer));
+    if (httpParser->parserStatus == HTTP_PARSE_OK && httpParser->scan.state != HTTP_STATE_MESSAGE_HEAD_DONE) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_LINE_SEPARATORS;   // buffer ended before empty line
+        return;
+    }
+
+    if (httpParser->parserStatus == HTTP_PARSE_OK && !isMessageBodyNeedToBeSkipped(httpParser)) {
+        httpParser->messageBody = (char *) httpDataBuffer + httpParser->messageBodyOffset;
+    }
+}
+
+void resetHttpParser(HTTPParser *httpParser, HTTPParserType httpType) {
+    httpParser->contentLength = 0;
+    httpParser->method = HTTP_NO_METHOD;
+    httpParser->statusCode = HTTP_NO_STATUS;
+    httpParser->messageBody = NULL;
+    httpParser->httpType = httpType;
+    httpParser->parserStatus = HTTP_PARSE_OK;
+    httpParser->headersStartOffset = 0;
+    httpParser->headersEndOffset = 0;
+    httpParser->messageBodyOffset = 0;
+    httpParser->messageBodyLength = 0;
+    httpParser->messageLength = 0;
+    httpParser->parsedLength = 0;
+    httpParser->headerCount = 0;
+    httpParser->requestTarget = (HTTPRequestTarget) {0};
+    resetHttpChunkedDecoder(&httpParser->chunkedDecoder);
+
+    clearHttpParserStrings(httpParser);
+    memset(&httpParser->scan, 0, sizeof(HTTPParserScanState));
+    httpParser->scan.state = httpType == HTTP_REQUEST ? HTTP_STATE_START : HTTP_STATE_HTTP_CONSTANT;
+}
+
+HTTPParserStatus httpParserFeed(HTTPParser *httpParser, const char *data, size_t length) {
+    if (httpParser->parserStatus == HTTP_PARSE_NEED_MORE_DATA) {
+        httpParser->parserStatus = HTTP_PARSE_OK;
+    }
+    if (httpParser->parserStatus != HTTP_PARSE_OK || httpParser->scan.state == HTTP_STATE_MESSAGE_HEAD_DONE) {
+        return httpParser->parserStatus;    // errors are sticky until resetHttpParser()
+    }
+
+    size_t consumedLength = executeHttpParser(httpParser, data, length);
+    if (httpParser->parserStatus != HTTP_PARSE_OK) {
+        return httpParser->parserStatus;
+    }
+
+    if (httpParser->scan.state != HTTP_STATE_MESSAGE_HEAD_DONE) {
+        httpParser->parserStatus = HTTP_PARSE_NEED_MORE_DATA;
+    } else if (!isMessageBodyNeedToBeSkipped(httpParser)) {
+        httpParser->messageBody = (char *) data + consumedLength;   // body starts in this chunk
+    }
+    return httpParser->parserStatus;
+}
+
 void parseHttpHeaders(HTTPParser *httpParser, char *dataBuffer) {
     if (httpParser == NULL || isStringBlank(dataBuffer)) return;
-    initSingletonHashMap(&httpParser->headers, HTTP_HEADERS_MAP_INITIAL_CAPACITY);
-    hashMapClear(httpParser->headers);
+    clearHttpHeaders(httpParser);
 
     char *headersDelimiter = resolveHttpLineSeparator(dataBuffer);
     char headersEndDelimiter[HTTP_HEADERS_END_DELIMITER_LENGTH] = {0};
@@ -86,17 +514,35 @@ void parseHttpHeaders(HTTPParser *httpParser, char *dataBuffer) {
         headersEndPointer += strlen(headersEndDelimiter);
 
         uint32_t delimiterLength = strlen(headersDelimiter);
+        if ((size_t) (headersEndPointer - headersStartPointer) > httpParser->maxHeadersLength) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_HEADERS_TOO_LONG;
+            return;
+        }
         if ((headersStartPointer + delimiterLength) < headersEndPointer) {  // check that headers exist
             char *savePointer;
             char *header = splitStringReentrant(headersStartPointer, headersDelimiter, &savePointer);
+            uint16_t headerCount = 0;
             while (header != NULL) {
+                if (strlen(header) > httpParser->maxHeaderLineLength) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG;
+                    return;
+                }
 
                 if (strchr(header, ':') != NULL) {
+                    if (headerCount++ >= httpParser->maxHeaderCount) {
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_TOO_MANY_HEADERS;
+                        return;
+                    }
+                    char *headerColon = strchr(header, ':');
+                    if (headerColon > header && IS_SPACE_OR_TAB(*(headerColon - 1))) {
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;
+                        return;
+                    }
                     char *headerValue = strstr(header, ": ");
                     headerValue = headerValue != NULL ? headerValue + 2 : headerValue; // strlen(": ")
                     char *headerKey = strtok(header, ": ");
-                    if (isHttpHeaderKeyValid(headerKey) && isHttpHeaderValueValid(headerValue)) {
-                        hashMapPut(httpParser->headers, headerKey, headerValue);
+                    if (isHttpHeaderValid(httpParser, headerKey, headerKey != NULL ? strlen(headerKey) : 0, headerValue, headerValue != NULL ? strlen(headerValue) : 0)) {
+                        putHttpHeader(httpParser, headerKey, strlen(headerKey), headerValue);
                     }
                 }
 
@@ -111,6 +557,7 @@ void parseHttpHeaders(HTTPParser *httpParser, char *dataBuffer) {
 
 void parseHttpQueryParameters(HTTPParser *httpParser, char *url) {
     if (httpParser == NULL || isStringBlank(url)) return;
+    if (!isHttpParserMapAvailable(httpParser)) return;
     initSingletonHashMap(&httpParser->queryParameters, HTTP_QUERY_PARAM_MAP_INITIAL_CAPACITY);
     hashMapClear(httpParser->queryParameters);
 
@@ -135,255 +582,2117 @@ void parseHttpQueryParameters(HTTPParser *httpParser, char *url) {
     }
 }
 
-void deleteHttpParser(HTTPParser *httpParser) {
-    if (httpParser != NULL) {
-        hashMapDelete(httpParser->headers);
-        hashMapDelete(httpParser->queryParameters);
-        httpParser->headers = NULL;
-        httpParser->queryParameters = NULL;
-        free(httpParser);
-    }
-}
-
-static bool isHttpVersionSupported(const char *httpVersion) {
-    for (uint32_t i = 0; i < sizeof(HTTP_SUPPORTED_VERSIONS_ARRAY) / sizeof(char *); i++) {
-        if (strcmp(HTTP_SUPPORTED_VERSIONS_ARRAY[i], httpVersion) == 0) {
-            return true;
-        }
-    }
-    return false;
-}
-
-static void parseHttpVersion(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
-    const char *httpVersionPointer = strstr(dataBuffer, HTTP_CONSTANT_NAME_WITH_SLASH);
-    if (httpVersionPointer == NULL) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT;
+void parseHttpBufferN(const char *data, size_t length, HTTPParser *httpParser, HTTPParserType httpType) {
+    resetHttpParser(httpParser, httpType);
+    if (data == NULL || isHttpDataBlank(data, length)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_EMPTY_DATA;
         return;
     }
 
-    bool isAtLineStart = (dataBuffer - httpVersionPointer) == 0;
-    if (httpParser->httpType == HTTP_RESPONSE && !isAtLineStart) {  // check that HTTP constant at response beginning
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_CONSTANT;
+    executeHttpParser(httpParser, data, length);
+    if (httpParser->parserStatus == HTTP_PARSE_OK && httpParser->scan.state != HTTP_STATE_MESSAGE_HEAD_DONE) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_LINE_SEPARATORS;
         return;
     }
-    httpVersionPointer += strlen(HTTP_CONSTANT_NAME_WITH_SLASH);
 
-    if (!isdigit(*httpVersionPointer)) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
-        return;
+    if (httpParser->parserStatus == HTTP_PARSE_OK && !isMessageBodyNeedToBeSkipped(httpParser)) {
+        httpParser->messageBody = (char *) data + httpParser->messageBodyOffset;    // read only, not NUL terminated
     }
-    httpParser->httpVersion[0] = *httpVersionPointer;
-    httpVersionPointer++;
-
-    if (*httpVersionPointer != '.') {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
-        return;
+    if (httpParser->parserStatus == HTTP_PARSE_OK) {
+        frameHttpMessageBody(httpParser, data, length);     // message boundary only, incomplete body is not an error here
     }
-    httpParser->httpVersion[1] = *httpVersionPointer;
-    httpVersionPointer++;
+}
 
-    if (!isdigit(*httpVersionPointer)) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
-        return;
+size_t parseHttpBatch(const char *const buffers[], const size_t lengths[], HTTPParser *const parsers[], size_t count, HTTPParserType httpType) {
+    size_t parsedCount = 0;
+    for (size_t i = 0; i < count && i < HTTP_BATCH_PREFETCH_DISTANCE; i++) {
+        prefetchHttpBatchMessage(buffers[i], lengths[i], parsers[i]);
     }
-    httpParser->httpVersion[2] = *httpVersionPointer;
 
-    if (!isHttpVersionSupported(httpParser->httpVersion)) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_SUPPORTED_HTTP_VERSION;
+    for (size_t i = 0; i < count; i++) {
+        if (i + HTTP_BATCH_PREFETCH_DISTANCE < count) {   // next messages load while this one is parsed
+            size_t next = i + HTTP_BATCH_PREFETCH_DISTANCE;
+            prefetchHttpBatchMessage(buffers[next], lengths[next], parsers[next]);
+        }
+        parseHttpBufferN(buffers[i], lengths[i], parsers[i], httpType);
+        if (parsers[i]->parserStatus == HTTP_PARSE_OK) {
+            parsedCount++;
+        }
     }
+    return parsedCount;
 }
 
-static void parseHttpContentLength(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
-    const char *httpContentLengthPointer = strstr(dataBuffer, CONTENT_TYPE_HEADER_NAME);
-    if (httpContentLengthPointer != NULL) {
-        httpContentLengthPointer += strlen(CONTENT_TYPE_HEADER_NAME);
-        char buffer[CONTENT_LENGTH_VALUE_BUFFER_SIZE] = {[0 ... CONTENT_LENGTH_VALUE_BUFFER_SIZE - 1] = 0};
-        for (uint8_t i = 0; isdigit(*httpContentLengthPointer); i++) {
-            buffer[i] = *httpContentLengthPointer;
-            httpContentLengthPointer++;
+void parseHttpHeadersN(HTTPParser *httpParser, const char *data, size_t length) {
+    if (httpParser == NULL || data == NULL || isHttpDataBlank(data, length)) return;
+    clearHttpHeaders(httpParser);
+
+    const char *end = data + length;
+    const char *lineStart = memchr(data, '\n', length);    // skip HTTP constant line
+    if (lineStart == NULL) return;
+    lineStart++;
+
+    size_t storageSize = (size_t) (end - lineStart) < httpParser->maxHeadersLength ? (size_t) (end - lineStart) : httpParser->maxHeadersLength;
+    char *storagePointer = reserveHttpParserStorage(httpParser, &httpParser->headersStorage, storageSize + 1);  // "key\0value\0" never exceeds "key:value\n"
+    if (storagePointer == NULL) return;
+
+    const char *headersStart = lineStart;
+    uint16_t headerCount = 0;
+    while (lineStart < end) {
+        size_t headersLength = lineStart - headersStart;
+        if (headersLength >= httpParser->maxHeadersLength) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_HEADERS_TOO_LONG;
+            return;
+        }
+        size_t scanLength = end - lineStart;    // line end is searched only within limits, "\r\n" included
+        scanLength = scanLength < httpParser->maxHeadersLength - headersLength ? scanLength : httpParser->maxHeadersLength - headersLength;
+        scanLength = scanLength < (size_t) httpParser->maxHeaderLineLength + 2 ? scanLength : (size_t) httpParser->maxHeaderLineLength + 2;
+
+        const char *lineEnd = memchr(lineStart, '\n', scanLength);
+        if (lineEnd == NULL) {
+            if (scanLength == (size_t) (end - lineStart)) break;     // incomplete line
+            httpParser->parserStatus = scanLength == httpParser->maxHeadersLength - headersLength ? HTTP_PARSE_ERROR_HEADERS_TOO_LONG : HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG;
+            return;
         }
+        const char *nextLine = lineEnd + 1;
+        if (lineEnd > lineStart && *(lineEnd - 1) == '\r') {
+            lineEnd--;
+        }
+        if (lineEnd == lineStart) break;    // empty line, end of headers
+        if ((size_t) (lineEnd - lineStart) > httpParser->maxHeaderLineLength) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG;
+            return;
+        }
+
+        const char *colon = memchr(lineStart, ':', lineEnd - lineStart);
+        if (colon != NULL && !IS_SPACE_OR_TAB(*lineStart)) {   // folded lines are skipped
+            if (headerCount++ >= httpParser->maxHeaderCount) {
+                httpParser->parserStatus = HTTP_PARSE_ERROR_TOO_MANY_HEADERS;
+                return;
+            }
+            if (colon > lineStart && IS_SPACE_OR_TAB(*(colon - 1))) {
+                httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;
+                return;
+            }
+            const char *valueStart = colon + 1;
+            const char *valueEnd = lineEnd;
+            trimHttpSpan(&valueStart, &valueEnd);
 
-        if (isStringNotEmpty(buffer)) {
-            httpParser->contentLength = strtoul(buffer, NULL, 10);
+            storagePointer = putHttpHeaderCopy(httpParser, storagePointer, lineStart, colon - lineStart, valueStart, valueEnd - valueStart);
         }
+        lineStart = nextLine;
     }
 }
 
-static void parseHttpMethod(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
-    const char *httpMethodPointer = dataBuffer;
-    char httpMethodBuffer[HTTP_METHOD_MAX_LENGTH + 1] = {[0 ... HTTP_METHOD_MAX_LENGTH] = 0};
-    for (uint8_t i = 0; !isspace(*httpMethodPointer) && i < HTTP_METHOD_MAX_LENGTH; i++) {
-        httpMethodBuffer[i] = *httpMethodPointer;
-        httpMethodPointer++;
+void parseHttpQueryParametersN(HTTPParser *httpParser, const char *url, size_t length) {
+    if (httpParser == NULL || url == NULL || isHttpDataBlank(url, length)) return;
+    if (!isHttpParserMapAvailable(httpParser)) return;
+    initSingletonHashMap(&httpParser->queryParameters, HTTP_QUERY_PARAM_MAP_INITIAL_CAPACITY);
+    hashMapClear(httpParser->queryParameters);
+
+    const char *parameterStart = memchr(url, '?', length);
+    if (parameterStart == NULL) return;
+    parameterStart++;   // skip "?"
+
+    const char *end = parameterStart;
+    const char *urlEnd = url + length;
+    while (end < urlEnd && *end != ' ' && *end != '#') {
+        end++;
     }
 
-    if (isStringBlank(httpMethodBuffer)) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_METHOD;
-        return;
+    char *storagePointer = reserveHttpParserStorage(httpParser, &httpParser->queryParametersStorage, end - parameterStart + 1);
+    if (storagePointer == NULL) return;
+
+    while (parameterStart < end) {
+        const char *parameterEnd = memchr(parameterStart, '&', end - parameterStart);
+        parameterEnd = parameterEnd != NULL ? parameterEnd : end;
+
+        const char *equalsSign = memchr(parameterStart, '=', parameterEnd - parameterStart);
+        if (equalsSign != NULL && equalsSign > parameterStart) {
+            char *argKey = storagePointer;
+            char *argValue = copyToHttpParserStorage(argKey, parameterStart, equalsSign - parameterStart);
+            storagePointer = copyToHttpParserStorage(argValue, equalsSign + 1, parameterEnd - equalsSign - 1);
+            hashMapPut(httpParser->queryParameters, argKey, argValue);
+        }
+        parameterStart = parameterEnd + 1;
     }
+}
 
-    HTTPMethod httpMethod = getHttpMethodByName(httpMethodBuffer);
-    if (httpMethod == HTTP_NO_METHOD) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_NO_SUCH_HTTP_METHOD;
-        return;
+HTTPQueryParameterIterator getHttpQueryParameterIterator(const HTTPParser *httpParser, const char *messageBuffer) {
+    HTTPQueryParameterIterator iterator = {0};
+    if (httpParser != NULL && messageBuffer != NULL) {
+        iterator = getHttpQueryStringIterator(messageBuffer + httpParser->requestTarget.queryOffset, httpParser->requestTarget.queryLength);
     }
-    httpParser->method = httpMethod;
+    return iterator;
 }
 
-static void parseUriPath(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
-    const char *targetRequestStartPointer = strstr(dataBuffer, HTTP_URI_ROOT_PATH_START);
-    const char *targetRequestEndPointer = strstr(dataBuffer, HTTP_CONSTANT_NAME_WITH_SLASH);
+HTTPQueryParameterIterator getHttpQueryStringIterator(const char *query, size_t length) {
+    HTTPQueryParameterIterator iterator = {0};
+    if (query != NULL) {
+        iterator.pointer = query;
+        iterator.end = query + length;
+    }
+    return iterator;
+}
 
-    if (targetRequestStartPointer > targetRequestEndPointer) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_URI_PATH_NOT_FOUND;
-        return;
-    } else if ((targetRequestEndPointer - targetRequestStartPointer) + 1 > HTTP_REQUEST_URI_PATH_LENGTH) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_URI_PATH_TOO_LONG;
-        return;
+bool httpQueryParameterHasNext(HTTPQueryParameterIterator *iterator) {
+    while (iterator->pointer < iterator->end) {
+        const char *parameterStart = iterator->pointer;
+        const char *parameterEnd = memchr(parameterStart, '&', iterator->end - parameterStart);
+        parameterEnd = parameterEnd != NULL ? parameterEnd : iterator->end;
+        iterator->pointer = parameterEnd < iterator->end ? parameterEnd + 1 : parameterEnd;
+
+        const char *equalsSign = memchr(parameterStart, '=', parameterEnd - parameterStart);
+        const char *keyEnd = equalsSign != NULL ? equalsSign : parameterEnd;
+        if (keyEnd == parameterStart) continue;     // empty pair or empty key
+        iterator->key = parameterStart;
+        iterator->keyLength = keyEnd - parameterStart;
+        iterator->value = equalsSign != NULL ? equalsSign + 1 : parameterEnd;
+        iterator->valueLength = parameterEnd - iterator->value;
+        return true;
     }
+    return false;
+}
 
-    for (uint32_t i = 0; !isspace(*targetRequestStartPointer) && *targetRequestStartPointer != '?'; i++) {
-        if (iscntrl(*targetRequestStartPointer)) {
-            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_URI_PATH;
-            return;
+bool decodeHttpQueryComponent(const char *data, size_t length, char *buffer, size_t bufferSize, size_t *decodedLength) {
+    if (data == NULL || buffer == NULL) return false;
+    const char *end = data + length;
+    char *output = buffer;
+    char *outputEnd = buffer + bufferSize;
+    while (data < end) {
+        const char *runEnd = findHttpCharRanges(data, end, &HTTP_QUERY_ESCAPE_CHARS);
+        size_t runLength = runEnd - data;
+        if (runLength > (size_t) (outputEnd - output)) return false;
+        memmove(output, data, runLength);   // output never passes input, so in place decoding is fine
+        output += runLength;
+        data = runEnd;
+        if (data == end) break;
+
+        if (output == outputEnd) return false;
+        if (*data == '+') {
+            *output++ = ' ';
+            data++;
+        } else if (decodeHttpPercentEscape(data, end, output)) {
+            output++;
+            data += 3;
+        } else {
+            return false;
         }
-        httpParser->uriPath[i] = *targetRequestStartPointer;
-        targetRequestStartPointer++;
     }
+
+    if (output < outputEnd) {
+        *output = '\0';
+    }
+    if (decodedLength != NULL) {
+        *decodedLength = output - buffer;
+    }
+    return true;
 }
 
-static void parseHttpStatusCode(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+bool normalizeHttpRequestPath(const HTTPParser *httpParser, const char *messageBuffer, char *buffer, size_t bufferSize, size_t *normalizedLength) {
+    if (httpParser == NULL || messageBuffer == NULL) return false;
+    return normalizeHttpPath(messageBuffer + httpParser->requestTarget.pathOffset, httpParser->requestTarget.pathLength, buffer, bufferSize, normalizedLength);
+}
 
-    const char *httpStatusCodePointer = strstr(dataBuffer, HTTP_CONSTANT_NAME_WITH_SLASH);
-    if (httpStatusCodePointer == NULL) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_STATUS_CODE_NOT_FOUND;
-        return;
-    }
-    httpStatusCodePointer += strlen(HTTP_CONSTANT_NAME_WITH_SLASH) + strlen(httpParser->httpVersion);   // skip "HTTP/1.1"
-    while (isspace(*httpStatusCodePointer)) {
-        httpStatusCodePointer++;
+bool getHttpUriPath(const HTTPParser *httpParser, const char *messageBuffer, char *buffer, size_t bufferSize) {
+    if (httpParser == NULL || messageBuffer == NULL || buffer == NULL || bufferSize == 0) return false;
+    size_t pathLength = httpParser->requestTarget.pathLength;
+    if (pathLength >= bufferSize) {
+        *buffer = '\0';
+        return false;
     }
+    memcpy(buffer, messageBuffer + httpParser->requestTarget.pathOffset, pathLength);
+    buffer[pathLength] = '\0';
+    return true;
+}
 
-    char httpStatusBuffer[HTTP_STATUS_LENGTH + 1] = {[0 ... HTTP_STATUS_LENGTH] = 0};
-    for (uint8_t i = 0; i < HTTP_STATUS_LENGTH; i++) {
-        if (isdigit(*httpStatusCodePointer)) {
-            httpStatusBuffer[i] = *httpStatusCodePointer;
-            httpStatusCodePointer++;
+bool normalizeHttpPath(const char *path, size_t length, char *buffer, size_t bufferSize, size_t *normalizedLength) {
+    if (path == NULL || buffer == NULL || bufferSize == 0) return false;
+    const char *end = path + length;
+    char *output = buffer;
+    char *outputEnd = buffer + bufferSize;
+    *output++ = '/';    // always absolute, leading slash of input is merged with it
+    char *segmentStart = output;
+
+    while (path < end) {
+        const char *runEnd = findHttpCharRanges(path, end, &HTTP_PATH_ESCAPE_CHARS);
+        size_t runLength = runEnd - path;
+        if (runLength > (size_t) (outputEnd - output)) return false;
+        memmove(output, path, runLength);
+        output += runLength;
+        path = runEnd;
+        if (path == end) break;
+
+        if (*path == '/') {
+            output = removeHttpDotSegment(buffer, segmentStart, output);
+            if (output[-1] != '/') {    // duplicate slashes are merged
+                if (output == outputEnd) return false;
+                *output++ = '/';
+            }
+            segmentStart = output;
+            path++;
+            continue;
+        }
+
+        char decoded;
+        if (!decodeHttpPercentEscape(path, end, &decoded) || decoded == '\0') return false;
+        if (decoded == '/') {   // stays escaped, decoded slash would split the segment
+            if (outputEnd - output < 3) return false;
+            memcpy(output, "%2F", 3);
+            output += 3;
         } else {
-            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
-            return;
+            if (output == outputEnd) return false;
+            *output++ = decoded;
         }
+        path += 3;
     }
 
-    bool isUnexpectedCharAfterCode = *httpStatusCodePointer != ' ';
-    if (isUnexpectedCharAfterCode) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
-        return;
+    output = removeHttpDotSegment(buffer, segmentStart, output);
+    if (output < outputEnd) {
+        *output = '\0';
+    }
+    if (normalizedLength != NULL) {
+        *normalizedLength = output - buffer;
     }
+    return true;
+}
 
-    uint32_t statusCode = strtoul(httpStatusBuffer, NULL, 10);
-    if (statusCode == 0 || statusCode >= HTTP_STATUS_CODE_MAX_VALUE) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
-        return;
+const HTTPHeaderSpan *findHttpHeaderSpan(const HTTPParser *httpParser, const char *messageBuffer, const char *name) {
+    if (httpParser == NULL || messageBuffer == NULL || name == NULL) return NULL;
+    size_t nameLength = strlen(name);
+    uint16_t indexSize = HTTP_HEADER_INDEX_SIZE(httpParser);
+    for (uint16_t i = 0; i < indexSize; i++) {
+        const HTTPHeaderSpan *headerSpan = &httpParser->headerIndex[i];
+        if (headerSpan->nameLength == nameLength && isHttpNameEqualIgnoreCase(messageBuffer + headerSpan->nameOffset, name, nameLength)) {
+            return headerSpan;
+        }
     }
-    httpParser->statusCode = statusCode;
+    return NULL;
+}
 
-    const char *httpStatusMessageStartPointer = httpStatusCodePointer;
-    while (*httpStatusMessageStartPointer != '\0' && isspace(*httpStatusMessageStartPointer)) {
-        httpStatusMessageStartPointer++;
+HTTPHeaderIterator getHttpHeaderIterator(const HTTPParser *httpParser, const char *messageBuffer) {
+    HTTPHeaderIterator iterator = {0};
+    if (httpParser != NULL && messageBuffer != NULL) {
+        iterator.span = httpParser->headerIndex;
+        iterator.spanEnd = httpParser->headerIndex + HTTP_HEADER_INDEX_SIZE(httpParser);
+        iterator.messageBuffer = messageBuffer;
     }
+    return iterator;
+}
 
-    const char *httpStatusMessageEndPointer = httpStatusMessageStartPointer;
-    while (*httpStatusMessageEndPointer != '\0' && *httpStatusMessageEndPointer != '\r' && *httpStatusMessageEndPointer != '\n') {
-        httpStatusMessageEndPointer++;
+bool httpHeaderHasNext(HTTPHeaderIterator *iterator) {
+    if (iterator->span == iterator->spanEnd) return false;
+    iterator->name = iterator->messageBuffer + iterator->span->nameOffset;
+    iterator->nameLength = iterator->span->nameLength;
+    iterator->value = iterator->messageBuffer + iterator->span->valueOffset;
+    iterator->valueLength = iterator->span->valueLength;
+    iterator->span++;
+    return true;
+}
+
+HTTPHeaderSpan httpFindHeader(HTTPParser *httpParser, const char *messageBuffer, const char *name) {
+    HTTPHeaderSpan headerSpan = {0};
+    if (httpParser == NULL || messageBuffer == NULL || name == NULL || *name == '\0') return headerSpan;
+    if (httpParser->headerCount > 0 && httpParser->headerCount <= HTTP_HEADER_INDEX_CAPACITY) {   // single-pass engine indexed all
+        const HTTPHeaderSpan *indexedSpan = findHttpHeaderSpan(httpParser, messageBuffer, name);
+        return indexedSpan != NULL ? *indexedSpan : headerSpan;
+    }
+    if (httpParser->headersEndOffset != 0) {
+        return findHttpHeaderBefore(httpParser, messageBuffer, messageBuffer + httpParser->headersEndOffset, name);
     }
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return headerSpan;  // buffer may be not NUL terminated, use httpFindHeaderN()
+    return findHttpHeaderBefore(httpParser, messageBuffer, messageBuffer + strlen(messageBuffer), name);
+}
 
-    uint16_t messageLength = httpStatusMessageEndPointer - httpStatusMessageStartPointer;
-    if (messageLength == 0) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_STATUS_CODE_MESSAGE_NOT_FOUND;
-        return;
+HTTPHeaderSpan httpFindHeaderN(HTTPParser *httpParser, const char *messageBuffer, size_t length, const char *name) {
+    HTTPHeaderSpan headerSpan = {0};
+    if (httpParser == NULL || messageBuffer == NULL || name == NULL || *name == '\0') return headerSpan;
+    if (httpParser->headerCount > 0 && httpParser->headerCount <= HTTP_HEADER_INDEX_CAPACITY) {
+        const HTTPHeaderSpan *indexedSpan = findHttpHeaderSpan(httpParser, messageBuffer, name);
+        bool isInLength = indexedSpan != NULL && (size_t) indexedSpan->valueOffset + indexedSpan->valueLength <= length;
+        return isInLength ? *indexedSpan : headerSpan;
     }
-    char statusCodeMessageBuffer[HTTP_STATUS_CODE_MESSAGE_MAX_LENGTH] = {0};
-    strncpy(statusCodeMessageBuffer, httpStatusMessageStartPointer, messageLength);
-    const char *statusCodeMeaning = getHttpStatusCodeMeaning(httpParser->statusCode);
+    size_t headersEndOffset = httpParser->headersEndOffset;
+    const char *dataEnd = messageBuffer + (headersEndOffset != 0 && headersEndOffset < length ? headersEndOffset : length);
+    return findHttpHeaderBefore(httpParser, messageBuffer, dataEnd, name);
+}
 
-    if (isStringNotEquals(statusCodeMeaning, trimString(statusCodeMessageBuffer))) {
-        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE;
-        return;
+static HTTPHeaderSpan findHttpHeaderBefore(HTTPParser *httpParser, const char *messageBuffer, const char *dataEnd, const char *name) {
+    HTTPHeaderSpan headerSpan = {0};
+    if (httpParser->headersStartOffset == 0) {
+        const char *requestLineEnd = memchr(messageBuffer, '\n', dataEnd - messageBuffer);
+        if (requestLineEnd == NULL) return headerSpan;
+        httpParser->headersStartOffset = requestLineEnd + 1 - messageBuffer;    // request line is skipped by next lookups
     }
+    if (messageBuffer + httpParser->headersStartOffset > dataEnd) return headerSpan;
+
+    const char *line = findHttpHeaderLine(messageBuffer, messageBuffer + httpParser->headersStartOffset, dataEnd, name, &headerSpan);
+    if (isHttpHeaderLineMalformed(line, dataEnd, &headerSpan)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;
+        return headerSpan;
+    }
+    if (headerSpan.nameLength == 0 && line != NULL && line < dataEnd && IS_LINE_END(*line)) {
+        httpParser->headersEndOffset = line - messageBuffer;   // whole block scanned, next misses stop here
+    }
+    return headerSpan;
 }
 
-static void parseHttpTransferEncoding(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
-    const char *httpTransferEncodingPointer = strstr(dataBuffer, TRANSFER_ENCODING_HEADER_NAME);
-    if (httpTransferEncodingPointer != NULL) {
-        httpTransferEncodingPointer += strlen(TRANSFER_ENCODING_HEADER_NAME);
-        for (uint8_t i = 0; *httpTransferEncodingPointer != '\r' && i < HTTP_TRANSFER_ENCODING_TYPES_LENGTH; i++) {
-            httpParser->transferEncodingTypes[i] = *httpTransferEncodingPointer;
-            httpTransferEncodingPointer++;
-        }
+void parseHttpHeadersFromIndex(HTTPParser *httpParser, const char *messageBuffer) {
+    if (httpParser == NULL || messageBuffer == NULL) return;
+    clearHttpHeaders(httpParser);
 
-        if (containsString(httpParser->transferEncodingTypes, "chunked") && httpParser->contentLength > 0) {
-            httpParser->parserStatus = HTTP_PARSE_ERROR_UNEXPECTED_CONTENT_LENGTH;// Cannot use chunked encoding and a content-length header together per the HTTP specification
-        }
+    size_t storageSize = 0;
+    HTTPHeaderIterator iterator = getHttpHeaderIterator(httpParser, messageBuffer);
+    while (httpHeaderHasNext(&iterator)) {
+        storageSize += iterator.nameLength + iterator.valueLength + 2;
+    }
+
+    char *storagePointer = reserveHttpParserStorage(httpParser, &httpParser->headersStorage, storageSize);
+    if (storagePointer == NULL) return;
+
+    iterator = getHttpHeaderIterator(httpParser, messageBuffer);
+    while (httpHeaderHasNext(&iterator)) {
+        storagePointer = putHttpHeaderCopy(httpParser, storagePointer, iterator.name, iterator.nameLength, iterator.value, iterator.valueLength);
     }
 }
 
-static void parseHttpMessageBody(const char *dataBuffer, HTTPParser *httpParser) {
-    if (httpParser->parserStatus != HTTP_PARSE_OK || isMessageBodyNeedToBeSkipped(httpParser)) return;
-    char *messageBodyPointer = strstr(dataBuffer, "\r\n\r\n");
-    if (messageBodyPointer != NULL) {
-        messageBodyPointer += strlen("\r\n\r\n");
-        httpParser->messageBody = messageBodyPointer;
-        return;
+const char *findHttpHeaderValue(const HTTPParser *httpParser, const char *name) {
+    if (httpParser == NULL || name == NULL) return NULL;
+    size_t length = strlen(name);
+    HTTPHeaderId headerId = getHttpHeaderId(name, length);
+    if (headerId != HTTP_HEADER_ID_UNKNOWN) {
+        return httpParser->knownHeaders[headerId];
     }
 
-    messageBodyPointer = strstr(dataBuffer, "\n\n");
-    if (messageBodyPointer != NULL) {
-        messageBodyPointer += strlen("\n\n");
-        httpParser->messageBody = messageBodyPointer;
-        return;
+    const char *value = NULL;
+    for (uint16_t i = 0; i < httpParser->unknownHeaderCount; i++) {     // last one wins, same as "headers" map
+        const HTTPHeaderEntry *header = &httpParser->unknownHeaders[i];
+        if (strlen(header->name) == length && isHttpNameEqualIgnoreCase(header->name, name, length)) {
+            value = header->value;
+        }
     }
-    httpParser->parserStatus = HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY;
+    return value;
 }
 
-static bool isMessageBodyNeedToBeSkipped(HTTPParser *httpParser) {
-    HTTPStatus statusCode = httpParser->statusCode;
-    return httpParser->httpType == HTTP_RESPONSE && (statusCode < HTTP_OK || statusCode == HTTP_NO_CONTENT || statusCode == HTTP_NOT_MODIFIED);
+HTTPHeaderId getHttpHeaderId(const char *name, size_t length) {
+    if (name == NULL || length == 0) return HTTP_HEADER_ID_UNKNOWN;
+    uint8_t slot = (length + HTTP_HEADER_ID_HASH_VALUES[HTTP_HEADER_ID_HASH_CHAR(name[0])] +
+                    HTTP_HEADER_ID_HASH_VALUES[HTTP_HEADER_ID_HASH_CHAR(name[length - 1])]) & HTTP_HEADER_ID_HASH_MASK;
+    HTTPHeaderId headerId = HTTP_HEADER_ID_HASH_SLOTS[slot];
+    const char *knownName = HTTP_HEADER_ID_NAMES[headerId];
+    if (knownName != NULL && strlen(knownName) == length && isHttpNameEqualIgnoreCase(knownName, name, length)) {
+        return headerId;
+    }
+    return HTTP_HEADER_ID_UNKNOWN;
 }
 
-static inline char *resolveHttpLineSeparator(const char *dataBuffer) {
-    if (containsString(dataBuffer, "\r\n\r\n")) {
-        return "\r\n";
-    } else if (containsString(dataBuffer, "\n\n")) {
-        return "\n";
+HTTPMessageIterator getHttpMessageIterator(const char *data, size_t length, HTTPParserType httpType) {
+    HTTPMessageIterator iterator = {data, length, 0, httpType, NULL};
+    return iterator;
+}
+
+bool httpMessageHasNext(HTTPMessageIterator *iterator, HTTPParser *httpParser) {
+    const char *data = iterator->data + iterator->offset;
+    size_t length = iterator->length - iterator->offset;
+    resetHttpParser(httpParser, iterator->httpType);
+    if (iterator->data == NULL || isHttpDataBlank(data, length)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_EMPTY_DATA;
+        return false;
     }
-    return "";
+
+    executeHttpParser(httpParser, data, length);
+    if (httpParser->parserStatus == HTTP_PARSE_OK && httpParser->scan.state != HTTP_STATE_MESSAGE_HEAD_DONE) {
+        httpParser->parserStatus = HTTP_PARSE_NEED_MORE_DATA;
+    }
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return false;
+
+    httpParser->parserStatus = frameHttpMessageBody(httpParser, data, length);
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return false;
+
+    if (!isMessageBodyNeedToBeSkipped(httpParser)) {
+        httpParser->messageBody = (char *) data + httpParser->messageBodyOffset;
+    }
+    iterator->message = data;
+    iterator->offset += httpParser->messageLength;
+    return true;
+}
+
+bool isHttpBodyChunked(const HTTPParser *httpParser) {
+    return httpParser != NULL && findHttpChunkedCoding(httpParser->transferEncodingTypes) == HTTP_CHUNKED_CODING_FINAL;
+}
+
+void resetHttpChunkedDecoder(HTTPChunkedDecoder *decoder) {
+    memset(decoder, 0, sizeof(HTTPChunkedDecoder));
+    decoder->state = HTTP_CHUNKED_STATE_SIZE;
+}
+
+HTTPParserStatus decodeHttpChunked(HTTPChunkedDecoder *decoder, char *data, size_t length) {
+    const char *pointer = data;
+    const char *end = data + length;
+    char *decodedEnd = data;
+    size_t runLength;
+    const char *run;
+    while ((run = nextHttpChunkedRun(decoder, &pointer, end, &runLength)) != NULL) {
+        memmove(decodedEnd, run, runLength);    // payload never moves forward, framing bytes are dropped
+        decodedEnd += runLength;
+    }
+
+    decoder->decodedLength = decodedEnd - data;
+    decoder->consumedLength = pointer - data;
+    return getHttpChunkedStatus(decoder);
+}
+
+HTTPParserStatus decodeHttpChunkedSpans(HTTPChunkedDecoder *decoder, const char *data, size_t length,
+                                        HTTPBodySpan *spans, uint16_t spanCapacity, uint16_t *spanCount) {
+    const char *pointer = data;
+    const char *end = data + length;
+    size_t runLength;
+    const char *run;
+    *spanCount = 0;
+    decoder->decodedLength = 0;
+    while (*spanCount < spanCapacity && (run = nextHttpChunkedRun(decoder, &pointer, end, &runLength)) != NULL) {
+        spans[(*spanCount)++] = (HTTPBodySpan) {run - data, runLength};
+        decoder->decodedLength += runLength;
+    }
+
+    decoder->consumedLength = pointer - data;   // less than length when spans are full, call again with the rest
+    return getHttpChunkedStatus(decoder);
+}
+
+bool setHttpScanImplementation(HTTPScanImplementation implementation) {
+    if (implementation == HTTP_SCAN_AUTO) {
+        const char *forceScalar = getenv(HTTP_FORCE_SCALAR_ENV_NAME);
+        if (forceScalar != NULL && isStringNotEmpty(forceScalar) && strcmp(forceScalar, "0") != 0) {
+            implementation = HTTP_SCAN_SCALAR;
+        } else if (isHttpScanImplementationSupported(HTTP_SCAN_AVX2)) {
+            implementation = HTTP_SCAN_AVX2;
+        } else if (isHttpScanImplementationSupported(HTTP_SCAN_SSE42)) {
+            implementation = HTTP_SCAN_SSE42;
+        } else {
+            implementation = HTTP_SCAN_SCALAR;
+        }
+    }
+
+    if (!isHttpScanImplementationSupported(implementation)) {
+        return false;
+    }
+
+    switch (implementation) {
+#if defined(HTTP_PARSER_X86_DISPATCH)
+        case HTTP_SCAN_AVX2:
+            findHttpCharRanges = findHttpCharRangesAvx2;
+            break;
+        case HTTP_SCAN_SSE42:
+            findHttpCharRanges = findHttpCharRangesSse42;
+            break;
+#endif
+        default:
+            findHttpCharRanges = findHttpCharRangesScalar;
+            break;
+    }
+    httpScanImplementation = implementation;
+    return true;
+}
+
+HTTPScanImplementation getHttpScanImplementation() {
+    return httpScanImplementation;
+}
+
+HTTPParserPool *getHttpParserPoolInstance(uint16_t capacity, const HTTPParserAllocator *allocator) {
+    allocator = allocator != NULL ? allocator : &HTTP_HEAP_ALLOCATOR;
+    HTTPParserPool *pool = allocator->allocate(allocator->context, sizeof(HTTPParserPool) + capacity * sizeof(HTTPParser *));
+    if (pool == NULL) return NULL;
+    pool->allocator = *allocator;
+    pool->capacity = capacity;
+    pool->freeCount = 0;
+
+    for (uint16_t i = 0; i < capacity; i++) {
+        HTTPParser *httpParser = getHttpParserInstanceWithAllocator(allocator);
+        if (httpParser == NULL) {
+            deleteHttpParserPool(pool);
+            return NULL;
+        }
+        resetHttpParser(httpParser, HTTP_REQUEST);
+        httpParser->pool = pool;
+        httpParser->isPooled = true;
+        pool->freeParsers[pool->freeCount++] = httpParser;
+    }
+    return pool;
+}
+
+HTTPParser *acquireHttpParser(HTTPParserPool *pool) {
+    if (pool == NULL || pool->freeCount == 0) return NULL;
+    HTTPParser *httpParser = pool->freeParsers[--pool->freeCount];    // most recently released first, still warm in cache
+    httpParser->isPooled = false;
+    return httpParser;
+}
+
+bool releaseHttpParser(HTTPParserPool *pool, HTTPParser *httpParser) {
+    if (pool == NULL || httpParser == NULL || httpParser->pool != pool || httpParser->isPooled) return false;
+    resetHttpParser(httpParser, httpParser->httpType);  // maps and storages keep their capacity
+    clearHttpKnownHeaders(httpParser);
+    httpParser->unknownHeaderCount = 0;
+    httpParser->isPooled = true;
+    pool->freeParsers[pool->freeCount++] = httpParser;
+    return true;
+}
+
+void deleteHttpParserPool(HTTPParserPool *pool) {
+    if (pool != NULL) {
+        for (uint16_t i = 0; i < pool->freeCount; i++) {
+            deleteHttpParser(pool->freeParsers[i]);
+        }
+        if (pool->allocator.release != NULL) {
+            pool->allocator.release(pool->allocator.context, pool, sizeof(HTTPParserPool) + pool->capacity * sizeof(HTTPParser *));
+        }
+    }
+}
+
+void initHttpParserArena(HTTPParserArena *arena, void *memory, size_t capacity) {
+    arena->data = memory;
+    arena->capacity = capacity;
+    resetHttpParserArena(arena);
+}
+
+HTTPParserAllocator getHttpParserArenaAllocator(HTTPParserArena *arena) {
+    HTTPParserAllocator allocator = {allocateHttpArena, reallocateHttpArena, NULL, arena};
+    return allocator;
+}
+
+void resetHttpParserArena(HTTPParserArena *arena) {
+    arena->used = 0;
+    arena->lastAllocation = NULL;
+}
+
+void initHttpSerializer(HTTPSerializer *serializer, HTTPIoVector *vectors, uint16_t capacity) {
+    serializer->vectors = vectors;
+    serializer->capacity = capacity;
+    serializer->count = 0;
+    serializer->length = 0;
+}
+
+uint16_t serializeHttpResponse(HTTPSerializer *serializer, HTTPStatus statusCode, const HTTPOutputHeader *headers, uint16_t headerCount,
+                               const HTTPBodySegment *body, uint16_t bodyCount) {
+    serializer->count = 0;
+    serializer->length = 0;
+    bool isComplete = statusCode >= 100 && isHttpStatusCodeValid(statusCode) &&
+                      appendHttpStatusLine(serializer, statusCode) &&
+                      appendHttpHeadersAndBody(serializer, headers, headerCount, body, bodyCount);
+    return completeHttpSerializer(serializer, isComplete);
+}
+
+uint16_t serializeHttpRequest(HTTPSerializer *serializer, HTTPMethod method, const char *target, const HTTPOutputHeader *headers, uint16_t headerCount,
+                              const HTTPBodySegment *body, uint16_t bodyCount) {
+    serializer->count = 0;
+    serializer->length = 0;
+    const HTTPMethodWord *methodWord = NULL;
+    for (uint8_t i = 0; i < sizeof(HTTP_METHOD_WORDS) / sizeof(HTTPMethodWord); i++) {
+        if (HTTP_METHOD_WORDS[i].method == method) {
+            methodWord = &HTTP_METHOD_WORDS[i];     // name with trailing space
+            break;
+        }
+    }
+    size_t targetLength = target != NULL ? strlen(target) : 0;
+    bool isComplete = methodWord != NULL && isHttpRequestTargetValid(target, targetLength) &&
+                      appendHttpVector(serializer, methodWord->word, methodWord->length) &&
+                      appendHttpVector(serializer, target, targetLength) &&
+                      appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_REQUEST_LINE_END)) &&
+                      appendHttpHeadersAndBody(serializer, headers, headerCount, body, bodyCount);
+    return completeHttpSerializer(serializer, isComplete);
+}
+
+void deleteHttpParser(HTTPParser *httpParser) {
+    if (httpParser != NULL) {
+        hashMapDelete(httpParser->headers);     // maps are allocated by HashMap itself
+        hashMapDelete(httpParser->queryParameters);
+        httpParser->headers = NULL;
+        httpParser->queryParameters = NULL;
+
+        HTTPParserAllocator allocator = httpParser->allocator;
+        if (allocator.release != NULL) {
+            allocator.release(allocator.context, httpParser->headersStorage.data, httpParser->headersStorage.capacity);
+            allocator.release(allocator.context, httpParser->queryParametersStorage.data, httpParser->queryParametersStorage.capacity);
+            allocator.release(allocator.context, httpParser->unknownHeaders, httpParser->unknownHeaderCapacity * sizeof(HTTPHeaderEntry));
+            allocator.release(allocator.context, httpParser, sizeof(struct HTTPParser));
+        }
+    }
+}
+
+static bool isHttpVersionSupported(const char *httpVersion) {
+    for (uint32_t i = 0; i < sizeof(HTTP_SUPPORTED_VERSIONS_ARRAY) / sizeof(char *); i++) {
+        if (strcmp(HTTP_SUPPORTED_VERSIONS_ARRAY[i], httpVersion) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void parseHttpVersion(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+    const char *httpVersionPointer = strstr(dataBuffer, HTTP_CONSTANT_NAME_WITH_SLASH);
+    if (httpVersionPointer == NULL) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT;
+        return;
+    }
+
+    bool isAtLineStart = (dataBuffer - httpVersionPointer) == 0;
+    if (httpParser->httpType == HTTP_RESPONSE && !isAtLineStart) {  // check that HTTP constant at response beginning
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_CONSTANT;
+        return;
+    }
+    httpVersionPointer += strlen(HTTP_CONSTANT_NAME_WITH_SLASH);
+
+    if (!IS_HTTP_DIGIT(*httpVersionPointer)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
+        return;
+    }
+    httpParser->httpVersion[0] = *httpVersionPointer;
+    httpVersionPointer++;
+
+    if (*httpVersionPointer != '.') {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
+        return;
+    }
+    httpParser->httpVersion[1] = *httpVersionPointer;
+    httpVersionPointer++;
+
+    if (!IS_HTTP_DIGIT(*httpVersionPointer)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
+        return;
+    }
+    httpParser->httpVersion[2] = *httpVersionPointer;
+
+    if (!isHttpVersionSupported(httpParser->httpVersion)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_SUPPORTED_HTTP_VERSION;
+    }
+}
+
+static void parseHttpContentLength(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+    HTTPHeaderSpan headerSpan = httpFindHeader(httpParser, dataBuffer, CONTENT_LENGTH_HEADER_NAME);
+    if (headerSpan.nameLength == 0 || httpParser->parserStatus != HTTP_PARSE_OK) return;
+    if (!parseHttpContentLengthValue(dataBuffer + headerSpan.valueOffset, headerSpan.valueLength, &httpParser->contentLength)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH;
+        return;
+    }
+
+    const char *nextLine = strchr(dataBuffer + headerSpan.valueOffset, '\n');
+    HTTPHeaderSpan repeatedSpan = {0};
+    if (nextLine != NULL) {
+        const char *dataEnd = nextLine + strlen(nextLine);
+        const char *repeatedLine = findHttpHeaderLine(dataBuffer, nextLine + 1, dataEnd, CONTENT_LENGTH_HEADER_NAME, &repeatedSpan);
+        if (isHttpHeaderLineMalformed(repeatedLine, dataEnd, &repeatedSpan)) {
+            httpParser->contentLength = 0;
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;
+            return;
+        }
+    }
+    if (repeatedSpan.nameLength > 0) {
+        httpParser->contentLength = 0;
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH;   // repeated, even same value, can smuggle a request
+    }
+}
+
+static void parseHttpMethod(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+    if (strnlen(dataBuffer, sizeof(uint64_t)) == sizeof(uint64_t)) {
+        const HTTPMethodWord *methodWord = matchHttpMethodWord(dataBuffer);
+        if (methodWord != NULL) {
+            httpParser->method = methodWord->method;
+            return;
+        }
+    }
+
+    const char *httpMethodPointer = dataBuffer;
+    char httpMethodBuffer[HTTP_METHOD_MAX_LENGTH + 1] = {[0 ... HTTP_METHOD_MAX_LENGTH] = 0};
+    for (uint8_t i = 0; !IS_HTTP_WHITESPACE(*httpMethodPointer) && i < HTTP_METHOD_MAX_LENGTH; i++) {
+        httpMethodBuffer[i] = *httpMethodPointer;
+        httpMethodPointer++;
+    }
+
+    if (isStringBlank(httpMethodBuffer)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_METHOD;
+        return;
+    }
+
+    HTTPMethod httpMethod = getHttpMethodByName(httpMethodBuffer);
+    if (httpMethod == HTTP_NO_METHOD) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_NO_SUCH_HTTP_METHOD;
+        return;
+    }
+    httpParser->method = httpMethod;
+}
+
+static void parseUriPath(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+    const char *targetRequestStartPointer = strstr(dataBuffer, HTTP_URI_ROOT_PATH_START);
+    const char *targetRequestEndPointer = strstr(dataBuffer, HTTP_CONSTANT_NAME_WITH_SLASH);
+
+    if (targetRequestStartPointer > targetRequestEndPointer) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_URI_PATH_NOT_FOUND;
+        return;
+    }
+
+    bool isTargetChecked = IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_REQUEST_TARGET);
+    const char *targetRequestPointer = targetRequestStartPointer;
+    while (!IS_HTTP_WHITESPACE(*targetRequestPointer)) {
+        if (*targetRequestPointer == '\0' || (isTargetChecked && IS_HTTP_CTL(*targetRequestPointer))) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_URI_PATH;
+            return;
+        } else if ((size_t) (targetRequestPointer - targetRequestStartPointer) >= httpParser->maxRequestTargetLength) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_URI_PATH_TOO_LONG;
+            return;
+        }
+        targetRequestPointer++;
+    }
+
+    HTTPRequestTarget *requestTarget = &httpParser->requestTarget;
+    const char *fragmentPointer = memchr(targetRequestStartPointer, '#', targetRequestPointer - targetRequestStartPointer);
+    const char *pathAndQueryEnd = fragmentPointer != NULL ? fragmentPointer : targetRequestPointer;
+    const char *queryPointer = memchr(targetRequestStartPointer, '?', pathAndQueryEnd - targetRequestStartPointer);
+    const char *pathEnd = queryPointer != NULL ? queryPointer : pathAndQueryEnd;
+    requestTarget->pathOffset = targetRequestStartPointer - dataBuffer;
+    requestTarget->pathLength = pathEnd - targetRequestStartPointer;
+    if (queryPointer != NULL) {
+        requestTarget->queryOffset = queryPointer + 1 - dataBuffer;
+        requestTarget->queryLength = pathAndQueryEnd - queryPointer - 1;
+    }
+    if (fragmentPointer != NULL) {
+        requestTarget->fragmentOffset = fragmentPointer + 1 - dataBuffer;
+        requestTarget->fragmentLength = targetRequestPointer - fragmentPointer - 1;
+    }
+}
+
+static void parseHttpStatusCode(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+
+    const char *httpStatusCodePointer = strstr(dataBuffer, HTTP_CONSTANT_NAME_WITH_SLASH);
+    if (httpStatusCodePointer == NULL) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_STATUS_CODE_NOT_FOUND;
+        return;
+    }
+    httpStatusCodePointer += strlen(HTTP_CONSTANT_NAME_WITH_SLASH) + strlen(httpParser->httpVersion);   // skip "HTTP/1.1"
+    while (IS_HTTP_WHITESPACE(*httpStatusCodePointer)) {
+        httpStatusCodePointer++;
+    }
+
+    char httpStatusBuffer[HTTP_STATUS_LENGTH + 1] = {[0 ... HTTP_STATUS_LENGTH] = 0};
+    for (uint8_t i = 0; i < HTTP_STATUS_LENGTH; i++) {
+        if (IS_HTTP_DIGIT(*httpStatusCodePointer)) {
+            httpStatusBuffer[i] = *httpStatusCodePointer;
+            httpStatusCodePointer++;
+        } else {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
+            return;
+        }
+    }
+
+    bool isReasonPhraseChecked = IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_REASON_PHRASE);
+    bool isUnexpectedCharAfterCode = *httpStatusCodePointer != ' ' && (isReasonPhraseChecked || !IS_LINE_END(*httpStatusCodePointer));
+    if (isUnexpectedCharAfterCode) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
+        return;
+    }
+
+    uint32_t statusCode = strtoul(httpStatusBuffer, NULL, 10);
+    if (!isHttpStatusCodeValid(statusCode)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
+        return;
+    }
+    httpParser->statusCode = statusCode;
+    if (!isReasonPhraseChecked) return;     // reason phrase is not copied at all
+
+    const char *httpStatusMessageStartPointer = httpStatusCodePointer;
+    while (*httpStatusMessageStartPointer != '\0' && IS_HTTP_WHITESPACE(*httpStatusMessageStartPointer)) {
+        httpStatusMessageStartPointer++;
+    }
+
+    const char *httpStatusMessageEndPointer = httpStatusMessageStartPointer;
+    while (*httpStatusMessageEndPointer != '\0' && *httpStatusMessageEndPointer != '\r' && *httpStatusMessageEndPointer != '\n') {
+        httpStatusMessageEndPointer++;
+    }
+
+    uint16_t messageLength = httpStatusMessageEndPointer - httpStatusMessageStartPointer;
+    if (messageLength == 0) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_STATUS_CODE_MESSAGE_NOT_FOUND;
+        return;
+    }
+    char statusCodeMessageBuffer[HTTP_STATUS_CODE_MESSAGE_MAX_LENGTH] = {0};
+    strncpy(statusCodeMessageBuffer, httpStatusMessageStartPointer, messageLength);
+    const char *statusCodeMeaning = getHttpStatusCodeMeaning(httpParser->statusCode);
+
+    if (isStringNotEquals(statusCodeMeaning, trimString(statusCodeMessageBuffer))) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE;
+        return;
+    }
+}
+
+static void parseHttpTransferEncoding(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK) return;
+    HTTPHeaderSpan headerSpan = httpFindHeader(httpParser, dataBuffer, TRANSFER_ENCODING_HEADER_NAME);
+    if (headerSpan.nameLength == 0 || httpParser->parserStatus != HTTP_PARSE_OK) return;
+
+    size_t length = 0;
+    while (headerSpan.nameLength > 0) {     // repeated header continues the list, last one has final coding
+        if (!appendHttpTransferCodings(httpParser, &length, dataBuffer + headerSpan.valueOffset, headerSpan.valueLength)) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING;
+            return;
+        }
+        const char *nextLine = strchr(dataBuffer + headerSpan.valueOffset, '\n');
+        headerSpan = (HTTPHeaderSpan) {0};
+        if (nextLine == NULL) break;
+        const char *dataEnd = nextLine + strlen(nextLine);
+        const char *line = findHttpHeaderLine(dataBuffer, nextLine + 1, dataEnd, TRANSFER_ENCODING_HEADER_NAME, &headerSpan);
+        if (isHttpHeaderLineMalformed(line, dataEnd, &headerSpan)) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;
+            return;
+        }
+    }
+    bool hasContentLength = httpFindHeader(httpParser, dataBuffer, CONTENT_LENGTH_HEADER_NAME).nameLength > 0;
+    httpParser->parserStatus = checkHttpTransferEncoding(httpParser, hasContentLength);
+}
+
+static bool appendHttpTransferCodings(HTTPParser *httpParser, size_t *length, const char *value, size_t valueLength) {
+    size_t separatorLength = *length > 0 ? strlen(HTTP_TRANSFER_CODING_SEPARATOR) : 0;
+    if (*length + separatorLength + valueLength > HTTP_TRANSFER_ENCODING_TYPES_LENGTH - 1) return false;     // final coding would be lost
+    memcpy(httpParser->transferEncodingTypes + *length, HTTP_TRANSFER_CODING_SEPARATOR, separatorLength);
+    memcpy(httpParser->transferEncodingTypes + *length + separatorLength, value, valueLength);
+    *length += separatorLength + valueLength;
+    httpParser->transferEncodingTypes[*length] = '\0';
+    return true;
+}
+
+static void parseHttpMessageBody(const char *dataBuffer, HTTPParser *httpParser) {
+    if (httpParser->parserStatus != HTTP_PARSE_OK || isMessageBodyNeedToBeSkipped(httpParser)) return;
+    char *messageBodyPointer = strstr(dataBuffer, "\r\n\r\n");
+    if (messageBodyPointer != NULL) {
+        httpParser->headersEndOffset = messageBodyPointer + strlen("\r\n") - dataBuffer;
+        messageBodyPointer += strlen("\r\n\r\n");
+    } else {
+        messageBodyPointer = strstr(dataBuffer, "\n\n");
+        if (messageBodyPointer == NULL) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY;
+            return;
+        }
+        httpParser->headersEndOffset = messageBodyPointer + strlen("\n") - dataBuffer;
+        messageBodyPointer += strlen("\n\n");
+    }
+    httpParser->messageBody = messageBodyPointer;     // chunked body is left framed, see decodeHttpChunked()
+}
+
+static bool isMessageBodyNeedToBeSkipped(HTTPParser *httpParser) {
+    HTTPStatus statusCode = httpParser->statusCode;
+    return httpParser->httpType == HTTP_RESPONSE && (statusCode < HTTP_OK || statusCode == HTTP_NO_CONTENT || statusCode == HTTP_NOT_MODIFIED);
+}
+
+static inline char *resolveHttpLineSeparator(const char *dataBuffer) {
+    if (containsString(dataBuffer, "\r\n\r\n")) {
+        return "\r\n";
+    } else if (containsString(dataBuffer, "\n\n")) {
+        return "\n";
+    }
+    return "";
+}
+
+static void onHttpLineEnd(HTTPParser *httpParser, char ch, uint32_t offset) {
+    if (ch == '\r') {
+        httpParser->scan.state = HTTP_STATE_LINE_ALMOST_DONE;
+        return;
+    }
+
+    if (httpParser->headersStartOffset == 0) {  // end of request or status line
+        httpParser->headersStartOffset = offset + 1;
+    }
+    httpParser->scan.lineStartOffset = offset + 1;
+    httpParser->scan.state = HTTP_STATE_HEADER_LINE_START;
+}
+
+static void onHttpRequestTargetChar(HTTPParser *httpParser, char ch, uint32_t offset) {
+    if (IS_LINE_END(ch)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT;
+    } else if (IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_REQUEST_TARGET) && IS_HTTP_CTL(ch)) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_URI_PATH;
+    } else if (offset + 1 - httpParser->requestTarget.pathOffset > httpParser->maxRequestTargetLength) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_URI_PATH_TOO_LONG;
+    }
+}
+
+static void onHttpRequestTargetPartEnd(HTTPParser *httpParser, char ch, uint32_t offset) {
+    if (ch == '?') {
+        httpParser->requestTarget.queryOffset = offset + 1;
+        httpParser->scan.state = HTTP_STATE_URI_QUERY;
+    } else if (ch == '#') {
+        httpParser->requestTarget.fragmentOffset = offset + 1;
+        httpParser->scan.state = HTTP_STATE_URI_FRAGMENT;
+    } else {
+        httpParser->scan.state = HTTP_STATE_SPACES_BEFORE_HTTP_CONSTANT;
+    }
+}
+
+static const char *getHttpRequestTargetScanEnd(const HTTPParser *httpParser, const char *data, const char *pointer, const char *end) {
+    uint32_t targetLength = httpParser->parsedLength + (uint32_t) (pointer - data) - httpParser->requestTarget.pathOffset;
+    if (targetLength >= httpParser->maxRequestTargetLength) return pointer;
+    size_t remainingLength = httpParser->maxRequestTargetLength - targetLength;
+    return (size_t) (end - pointer) > remainingLength ? pointer + remainingLength : end;
+}
+
+static const char *getHttpHeadersScanEnd(const HTTPParser *httpParser, const char *data, const char *pointer, const char *end) {
+    uint64_t lineLimit = (uint64_t) httpParser->scan.lineStartOffset + httpParser->maxHeaderLineLength;
+    uint64_t headersLimit = (uint64_t) httpParser->headersStartOffset + httpParser->maxHeadersLength;
+    uint64_t limit = lineLimit < headersLimit ? lineLimit : headersLimit;
+    uint64_t offset = httpParser->parsedLength + (uint64_t) (pointer - data);
+    if (limit <= offset) return pointer;    // next byte goes to per byte path and its limit check
+    return (uint64_t) (end - pointer) > limit - offset ? pointer + (limit - offset) : end;
+}
+
+static void checkHttpHeaderLimits(HTTPParser *httpParser, char ch, uint32_t offset) {
+    if (offset - httpParser->headersStartOffset >= httpParser->maxHeadersLength) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_HEADERS_TOO_LONG;
+    } else if (!IS_LINE_END(ch) && offset - httpParser->scan.lineStartOffset >= httpParser->maxHeaderLineLength) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG;
+    }
+}
+
+static void onHttpHeaderNameEnd(HTTPParser *httpParser, uint32_t offset) {
+    HTTPParserScanState *scan = &httpParser->scan;
+    if (httpParser->headerCount >= httpParser->maxHeaderCount) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_TOO_MANY_HEADERS;
+        return;
+    }
+    if (httpParser->headerCount < HTTP_HEADER_INDEX_CAPACITY) {
+        HTTPHeaderSpan *headerSpan = &httpParser->headerIndex[httpParser->headerCount];
+        headerSpan->nameOffset = scan->headerNameOffset;
+        headerSpan->nameLength = scan->headerNameLength;
+        headerSpan->valueOffset = offset + 1;     // empty value
+        headerSpan->valueLength = 0;
+    }
+    if (httpParser->headerCount < UINT16_MAX) {
+        httpParser->headerCount++;
+    }
+
+    scan->headerType = HTTP_HEADER_TYPE_NONE;
+    for (uint8_t i = 0; i < HTTP_SCANNED_HEADER_COUNT; i++) {
+        uint8_t headerBit = 1 << i;
+        if ((scan->headerMatchMask & headerBit) && HTTP_SCANNED_HEADER_NAMES[i][scan->tokenLength] == '\0') {
+            if ((scan->seenHeadersMask & headerBit) == 0 || i + 1 == HTTP_HEADER_TYPE_TRANSFER_ENCODING) {
+                scan->seenHeadersMask |= headerBit;
+                scan->headerType = i + 1;
+            } else if (i + 1 == HTTP_HEADER_TYPE_CONTENT_LENGTH) {
+                httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH;   // repeated, even same value, can smuggle a request
+            }
+            break;
+        }
+    }
+    scan->tokenLength = 0;
+    if (scan->headerType == HTTP_HEADER_TYPE_TRANSFER_ENCODING && httpParser->transferEncodingTypes[0] != '\0') {    // repeated header continues the list
+        size_t length = strnlen(httpParser->transferEncodingTypes, HTTP_TRANSFER_ENCODING_TYPES_LENGTH);
+        if (length + strlen(HTTP_TRANSFER_CODING_SEPARATOR) >= HTTP_TRANSFER_ENCODING_TYPES_LENGTH - 1) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING;
+            return;
+        }
+        memcpy(httpParser->transferEncodingTypes + length, HTTP_TRANSFER_CODING_SEPARATOR, strlen(HTTP_TRANSFER_CODING_SEPARATOR));
+        scan->tokenLength = length + strlen(HTTP_TRANSFER_CODING_SEPARATOR);
+    }
+    scan->contentLengthState = HTTP_CONTENT_LENGTH_EMPTY;
+}
+
+static void onHttpHeaderNameChar(HTTPParserScanState *scan, char ch) {     // header names are case-insensitive, RFC 9110 5.1
+    for (uint8_t i = 0; i < HTTP_SCANNED_HEADER_COUNT; i++) {
+        uint8_t headerBit = 1 << i;
+        if ((scan->headerMatchMask & headerBit) && HTTP_SCANNED_HEADER_NAMES[i][scan->tokenLength] != HTTP_ASCII_LOWER(ch)) {
+            scan->headerMatchMask &= ~headerBit;    // mismatched names are not compared anymore, so no read past their end
+        }
+    }
+    if (scan->headerMatchMask != 0) {
+        scan->tokenLength++;
+    }
+}
+
+static HTTPHeaderSpan *getCurrentHttpHeaderSpan(HTTPParser *httpParser) {
+    uint16_t headerCount = httpParser->headerCount;
+    return headerCount > 0 && headerCount <= HTTP_HEADER_INDEX_CAPACITY ? &httpParser->headerIndex[headerCount - 1] : NULL;
+}
+
+static void onHttpHeaderValueChar(HTTPParser *httpParser, char ch) {
+    HTTPParserScanState *scan = &httpParser->scan;
+    if (scan->headerType == HTTP_HEADER_TYPE_CONTENT_LENGTH) {
+        onHttpContentLengthChar(httpParser, ch);
+    } else if (scan->headerType == HTTP_HEADER_TYPE_TRANSFER_ENCODING) {
+        if (scan->tokenLength == HTTP_TRANSFER_ENCODING_TYPES_LENGTH - 1) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING;    // final coding would be lost
+            return;
+        }
+        httpParser->transferEncodingTypes[scan->tokenLength++] = ch;
+    }
+}
+
+static void onHttpContentLengthChar(HTTPParser *httpParser, char ch) {
+    HTTPParserScanState *scan = &httpParser->scan;
+    if (IS_HTTP_DIGIT(ch) && scan->contentLengthState != HTTP_CONTENT_LENGTH_ENDED) {
+        uint8_t digit = ch - '0';
+        if (httpParser->contentLength > (UINT64_MAX - digit) / 10) {
+            httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH;
+            return;
+        }
+        httpParser->contentLength = httpParser->contentLength * 10 + digit;
+        scan->contentLengthState = HTTP_CONTENT_LENGTH_DIGITS;
+    } else if (IS_SPACE_OR_TAB(ch) && scan->contentLengthState != HTTP_CONTENT_LENGTH_EMPTY) {
+        scan->contentLengthState = HTTP_CONTENT_LENGTH_ENDED;
+    } else {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH;
+    }
+}
+
+static bool isHttpStatusMessageCharMatch(HTTPParserScanState *scan, char ch) {
+    const char *expected = scan->statusCodeMeaning + scan->statusMessageMatchLength;
+    if (IS_SPACE_OR_TAB(ch) && (scan->statusMessageTrailingSpaces > 0 || *expected != ch)) {
+        scan->statusMessageTrailingSpaces++;    // trimmed at line end, invalid when followed by text
+        return true;
+    }
+
+    if (scan->statusMessageTrailingSpaces > 0 || *expected == '\0' || *expected != ch) {
+        return false;   // nothing is matched past end of expected phrase
+    }
+    scan->statusMessageMatchLength++;
+    return true;
+}
+
+static bool isHttpStatusCodeValid(uint32_t statusCode) {
+    return statusCode != 0 && statusCode < HTTP_STATUS_CODE_MAX_VALUE;
+}
+
+static void onHttpStatusCodeEnd(HTTPParser *httpParser) {  // unchecked reason phrase is skipped like ignored header line
+    if (IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_REASON_PHRASE)) {
+        httpParser->scan.statusCodeMeaning = getHttpStatusCodeMeaning(httpParser->statusCode);
+        httpParser->scan.state = HTTP_STATE_SPACES_BEFORE_STATUS_MESSAGE;
+    } else {
+        httpParser->scan.state = HTTP_STATE_SKIP_HEADER_LINE;
+    }
+}
+
+static size_t executeHttpParser(HTTPParser *httpParser, const char *data, size_t length) {
+    HTTPParserScanState *scan = &httpParser->scan;
+    const char *pointer = data;
+    const char *end = data + length;
+    HTTPHeaderSpan *headerSpan;
+
+    while (pointer < end && httpParser->parserStatus == HTTP_PARSE_OK && scan->state != HTTP_STATE_MESSAGE_HEAD_DONE) {
+        bool isHeaderBlock = httpParser->headersStartOffset != 0;   // header limits apply after start line
+        pointer = skipHttpPlainChars(httpParser, data, pointer, isHeaderBlock ? getHttpHeadersScanEnd(httpParser, data, pointer, end) : end);
+        if (pointer == end || httpParser->parserStatus != HTTP_PARSE_OK) break;
+
+        uint32_t offset = httpParser->parsedLength + (uint32_t) (pointer - data);
+        char ch = *pointer++;
+        if (isHeaderBlock) {
+            checkHttpHeaderLimits(httpParser, ch, offset);
+            if (httpParser->parserStatus != HTTP_PARSE_OK) break;
+        }
+
+        switch (scan->state) {
+            case HTTP_STATE_START:
+                if (IS_LINE_END(ch)) break;     // ignore empty lines before request line
+                scan->state = HTTP_STATE_METHOD;
+                /* fall through */
+            case HTTP_STATE_METHOD:
+                if (IS_SPACE_OR_TAB(ch)) {
+                    if (scan->tokenLength == 0) {
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_METHOD;
+                        break;
+                    }
+                    httpParser->method = getHttpMethodByName(scan->methodBuffer);
+                    httpParser->parserStatus = httpParser->method == HTTP_NO_METHOD ? HTTP_PARSE_ERROR_NO_SUCH_HTTP_METHOD : HTTP_PARSE_OK;
+                    scan->state = HTTP_STATE_SPACES_BEFORE_URI;
+                } else if (IS_LINE_END(ch)) {
+                    httpParser->parserStatus = scan->tokenLength == 0 ? HTTP_PARSE_ERROR_NOT_FOUND_HTTP_METHOD : HTTP_PARSE_ERROR_URI_PATH_NOT_FOUND;
+                } else if (scan->tokenLength >= HTTP_METHOD_MAX_LENGTH) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_NO_SUCH_HTTP_METHOD;
+                } else {
+                    scan->methodBuffer[scan->tokenLength++] = ch;
+                }
+                break;
+
+            case HTTP_STATE_SPACES_BEFORE_URI:
+                if (IS_SPACE_OR_TAB(ch)) break;
+                if (ch != *HTTP_URI_ROOT_PATH_START) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_URI_PATH_NOT_FOUND;
+                    break;
+                }
+                httpParser->requestTarget.pathOffset = offset;
+                scan->state = HTTP_STATE_URI_PATH;
+                /* fall through */
+            case HTTP_STATE_URI_PATH:
+                if (IS_SPACE_OR_TAB(ch) || ch == '?' || ch == '#') {
+                    httpParser->requestTarget.pathLength = offset - httpParser->requestTarget.pathOffset;
+                    onHttpRequestTargetPartEnd(httpParser, ch, offset);
+                } else {
+                    onHttpRequestTargetChar(httpParser, ch, offset);
+                }
+                break;
+
+            case HTTP_STATE_URI_QUERY:
+                if (IS_SPACE_OR_TAB(ch) || ch == '#') {
+                    httpParser->requestTarget.queryLength = offset - httpParser->requestTarget.queryOffset;
+                    onHttpRequestTargetPartEnd(httpParser, ch, offset);
+                } else {
+                    onHttpRequestTargetChar(httpParser, ch, offset);
+                }
+                break;
+
+            case HTTP_STATE_URI_FRAGMENT:
+                if (IS_SPACE_OR_TAB(ch)) {
+                    httpParser->requestTarget.fragmentLength = offset - httpParser->requestTarget.fragmentOffset;
+                    scan->state = HTTP_STATE_SPACES_BEFORE_HTTP_CONSTANT;
+                } else {
+                    onHttpRequestTargetChar(httpParser, ch, offset);
+                }
+                break;
+
+            case HTTP_STATE_SPACES_BEFORE_HTTP_CONSTANT:
+                if (IS_SPACE_OR_TAB(ch)) break;
+                scan->tokenLength = 0;
+                scan->state = HTTP_STATE_HTTP_CONSTANT;
+                /* fall through */
+            case HTTP_STATE_HTTP_CONSTANT:
+                if (ch != HTTP_CONSTANT_NAME_WITH_SLASH[scan->tokenLength]) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT;
+                    break;
+                }
+                if (++scan->tokenLength == HTTP_CONSTANT_NAME_LENGTH) {
+                    scan->tokenLength = 0;
+                    scan->state = HTTP_STATE_HTTP_VERSION;
+                }
+                break;
+
+            case HTTP_STATE_HTTP_VERSION:
+                if (scan->tokenLength == 1 ? ch != '.' : !IS_HTTP_DIGIT(ch)) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
+                    break;
+                }
+                httpParser->httpVersion[scan->tokenLength++] = ch;
+
+                if (scan->tokenLength == HTTP_VERSION_CHAR_COUNT) {
+                    if (!isHttpVersionSupported(httpParser->httpVersion)) {
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_NOT_SUPPORTED_HTTP_VERSION;
+                        break;
+                    }
+                    scan->state = httpParser->httpType == HTTP_REQUEST ? HTTP_STATE_REQUEST_LINE_END : HTTP_STATE_SPACES_BEFORE_STATUS_CODE;
+                }
+                break;
+
+            case HTTP_STATE_REQUEST_LINE_END:
+                if (IS_LINE_END(ch)) {
+                    onHttpLineEnd(httpParser, ch, offset);
+                } else if (!IS_SPACE_OR_TAB(ch)) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_VERSION;
+                }
+                break;
+
+            case HTTP_STATE_SPACES_BEFORE_STATUS_CODE:
+                if (IS_SPACE_OR_TAB(ch)) break;
+                if (IS_LINE_END(ch)) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_STATUS_CODE_NOT_FOUND;
+                    break;
+                }
+                scan->tokenLength = 0;
+                scan->state = HTTP_STATE_STATUS_CODE;
+                /* fall through */
+            case HTTP_STATE_STATUS_CODE:
+                if (scan->tokenLength < HTTP_STATUS_LENGTH) {
+                    if (!IS_HTTP_DIGIT(ch)) {
+                        httpParser->statusCode = HTTP_NO_STATUS;
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
+                        break;
+                    }
+                    httpParser->statusCode = httpParser->statusCode * 10 + (ch - '0');
+                    scan->tokenLength++;
+                    break;
+                }
+
+                bool isReasonPhraseChecked = IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_REASON_PHRASE);
+                if ((ch != ' ' && (isReasonPhraseChecked || !IS_LINE_END(ch))) || !isHttpStatusCodeValid(httpParser->statusCode)) {
+                    httpParser->statusCode = HTTP_NO_STATUS;
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE;
+                    break;
+                }
+                onHttpStatusCodeEnd(httpParser);
+                if (IS_LINE_END(ch)) {  // empty reason phrase without separator, lenient only
+                    onHttpLineEnd(httpParser, ch, offset);
+                }
+                break;
+
+            case HTTP_STATE_SPACES_BEFORE_STATUS_MESSAGE:
+                if (IS_SPACE_OR_TAB(ch)) break;
+                if (IS_LINE_END(ch)) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_STATUS_CODE_MESSAGE_NOT_FOUND;
+                    break;
+                }
+                scan->state = HTTP_STATE_STATUS_MESSAGE;
+                /* fall through */
+            case HTTP_STATE_STATUS_MESSAGE:
+                if (IS_LINE_END(ch)) {
+                    if (scan->isStatusMessageMismatch || scan->statusCodeMeaning == NULL || scan->statusCodeMeaning[scan->statusMessageMatchLength] != '\0') {
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE;
+                        break;
+                    }
+                    onHttpLineEnd(httpParser, ch, offset);
+                } else if (IS_HTTP_CTL(ch) && ch != '\t') {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE;    // reason phrase is HTAB, SP, VCHAR, obs-text
+                } else if (!scan->isStatusMessageMismatch && scan->statusCodeMeaning != NULL) {
+                    scan->isStatusMessageMismatch = !isHttpStatusMessageCharMatch(scan, ch);
+                }
+                break;
+
+            case HTTP_STATE_LINE_ALMOST_DONE:
+                if (ch != '\n') {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_LINE_SEPARATORS;
+                    break;
+                }
+                onHttpLineEnd(httpParser, ch, offset);
+                break;
+
+            case HTTP_STATE_HEADER_LINE_START:
+                if (ch == '\r') {
+                    httpParser->headersEndOffset = offset;
+                    scan->state = HTTP_STATE_HEADERS_ALMOST_DONE;
+                    break;
+                } else if (ch == '\n') {
+                    httpParser->headersEndOffset = offset;
+                    httpParser->messageBodyOffset = offset + 1;
+                    scan->state = HTTP_STATE_MESSAGE_HEAD_DONE;
+                    break;
+                } else if (IS_SPACE_OR_TAB(ch) || ch == ':') {
+                    scan->state = HTTP_STATE_SKIP_HEADER_LINE;  // obsolete line folding or empty name
+                    break;
+                }
+                scan->tokenLength = 0;
+                scan->headerMatchMask = (1 << HTTP_SCANNED_HEADER_COUNT) - 1;
+                scan->headerNameOffset = offset;
+                scan->state = HTTP_STATE_HEADER_NAME;
+                /* fall through */
+            case HTTP_STATE_HEADER_NAME:
+                if (ch == ':') {
+                    scan->headerNameLength = offset - scan->headerNameOffset;
+                    onHttpHeaderNameEnd(httpParser, offset);
+                    scan->state = HTTP_STATE_SPACES_BEFORE_HEADER_VALUE;
+                } else if (IS_SPACE_OR_TAB(ch)) {
+                    scan->state = HTTP_STATE_SPACES_BEFORE_HEADER_COLON;
+                } else if (IS_LINE_END(ch)) {
+                    onHttpLineEnd(httpParser, ch, offset);  // no colon, line ignored
+                } else if (IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_HEADER_NAME) && !IS_HTTP_CHAR_CLASS(ch, HTTP_CHAR_TCHAR)) {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;
+                } else {
+                    onHttpHeaderNameChar(scan, ch);
+                }
+                break;
+
+            case HTTP_STATE_SPACES_BEFORE_HEADER_COLON:
+                if (ch == ':') {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;   // RFC 9112 5.1, no whitespace before colon
+                } else if (IS_LINE_END(ch)) {
+                    onHttpLineEnd(httpParser, ch, offset);
+                } else if (!IS_SPACE_OR_TAB(ch)) {
+                    scan->state = HTTP_STATE_SKIP_HEADER_LINE;
+                }
+                break;
+
+            case HTTP_STATE_SPACES_BEFORE_HEADER_VALUE:
+                if (IS_SPACE_OR_TAB(ch)) break;
+                headerSpan = getCurrentHttpHeaderSpan(httpParser);
+                if (headerSpan != NULL) {
+                    headerSpan->valueOffset = offset;
+                }
+                scan->state = HTTP_STATE_HEADER_VALUE;
+                /* fall through */
+            case HTTP_STATE_HEADER_VALUE:
+                if (IS_LINE_END(ch)) {
+                    if (scan->headerType == HTTP_HEADER_TYPE_CONTENT_LENGTH && scan->contentLengthState == HTTP_CONTENT_LENGTH_EMPTY) {
+                        httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH;
+                        break;
+                    }
+                    onHttpLineEnd(httpParser, ch, offset);
+                    break;
+                } else if (IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_HEADER_VALUE) && IS_HTTP_CTL(ch) && ch != '\t') {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_HEADER;     // bulk scan stops at these, so checked only here
+                    break;
+                }
+
+                onHttpHeaderValueChar(httpParser, ch);
+                headerSpan = getCurrentHttpHeaderSpan(httpParser);
+                if (headerSpan != NULL && !IS_SPACE_OR_TAB(ch)) {
+                    headerSpan->valueLength = offset + 1 - headerSpan->valueOffset;   // trailing spaces are excluded
+                }
+                break;
+
+            case HTTP_STATE_SKIP_HEADER_LINE:
+                if (IS_LINE_END(ch)) {
+                    onHttpLineEnd(httpParser, ch, offset);
+                }
+                break;
+
+            case HTTP_STATE_HEADERS_ALMOST_DONE:
+                if (ch != '\n') {
+                    httpParser->parserStatus = HTTP_PARSE_ERROR_INVALID_LINE_SEPARATORS;
+                    break;
+                }
+                httpParser->messageBodyOffset = offset + 1;
+                scan->state = HTTP_STATE_MESSAGE_HEAD_DONE;
+                break;
+
+            case HTTP_STATE_MESSAGE_HEAD_DONE:
+                break;
+        }
+    }
+
+    size_t consumedLength = pointer - data;
+    httpParser->parsedLength += consumedLength;
+    if (httpParser->parserStatus == HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH) {
+        httpParser->contentLength = 0;  // partial or first of repeated values is never reported, same as parseHttpBuffer()
+    }
+    if (httpParser->parserStatus == HTTP_PARSE_OK && scan->state == HTTP_STATE_MESSAGE_HEAD_DONE) {
+        onHttpMessageHeadComplete(httpParser);
+    }
+    return consumedLength;
+}
+
+static void onHttpMessageHeadComplete(HTTPParser *httpParser) {
+    uint8_t seenHeadersMask = httpParser->scan.seenHeadersMask;
+    if (seenHeadersMask & HTTP_HEADER_TYPE_BIT(HTTP_HEADER_TYPE_TRANSFER_ENCODING)) {
+        httpParser->parserStatus = checkHttpTransferEncoding(httpParser, seenHeadersMask & HTTP_HEADER_TYPE_BIT(HTTP_HEADER_TYPE_CONTENT_LENGTH));
+    }
+}
+
+// Transfer-Encoding is present: no Content-Length, chunked only once and only as final coding, RFC 9112 6.1 and 6.3
+static HTTPParserStatus checkHttpTransferEncoding(const HTTPParser *httpParser, bool hasContentLength) {
+    if (hasContentLength) return HTTP_PARSE_ERROR_UNEXPECTED_CONTENT_LENGTH;    // both together can smuggle a request
+    uint8_t chunkedCoding = findHttpChunkedCoding(httpParser->transferEncodingTypes);
+    if (chunkedCoding == HTTP_CHUNKED_CODING_NOT_FINAL || (httpParser->httpType == HTTP_REQUEST && chunkedCoding == HTTP_CHUNKED_CODING_NONE)) {
+        return HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING;     // request body length can't be determined
+    }
+    return HTTP_PARSE_OK;
+}
+
+static uint8_t findHttpChunkedCoding(const char *codings) {    // codings are case-insensitive tokens, empty list elements skipped
+    uint8_t chunkedCoding = HTTP_CHUNKED_CODING_NONE;
+    while (*codings != '\0') {
+        const char *separator = strchr(codings, ',');
+        const char *next = separator != NULL ? separator + 1 : codings + strlen(codings);
+        const char *coding = codings;
+        const char *codingEnd = separator != NULL ? separator : next;
+        trimHttpSpan(&coding, &codingEnd);
+        if (codingEnd > coding) {
+            if (chunkedCoding == HTTP_CHUNKED_CODING_FINAL) return HTTP_CHUNKED_CODING_NOT_FINAL;
+            if (codingEnd - coding == HTTP_CHUNKED_CODING_LENGTH && isHttpNameEqualIgnoreCase(coding, HTTP_CHUNKED_CODING_NAME, HTTP_CHUNKED_CODING_LENGTH)) {
+                chunkedCoding = HTTP_CHUNKED_CODING_FINAL;
+            }
+        }
+        codings = next;
+    }
+    return chunkedCoding;
+}
+
+// Bulk skip of bytes that can't change parser state, everything else goes through per byte state machine
+static const char *skipHttpPlainChars(HTTPParser *httpParser, const char *data, const char *pointer, const char *end) {
+    HTTPParserScanState *scan = &httpParser->scan;
+    const char *runEnd;
+    switch (scan->state) {
+        case HTTP_STATE_START:
+            if (end - pointer >= (long) sizeof(uint64_t) && !IS_LINE_END(*pointer)) {
+                const HTTPMethodWord *methodWord = matchHttpMethodWord(pointer);
+                if (methodWord != NULL) {
+                    httpParser->method = methodWord->method;
+                    scan->state = HTTP_STATE_SPACES_BEFORE_URI;
+                    return pointer + methodWord->length;
+                }
+                scan->state = HTTP_STATE_METHOD;    // unknown or malformed, per byte path reports error
+            }
+            return pointer;
+
+        case HTTP_STATE_HTTP_CONSTANT:  // response start only, request line reaches this state after target
+            if (httpParser->httpType == HTTP_RESPONSE && scan->tokenLength == 0 &&     // not inside constant split across chunks
+                end - pointer >= HTTP_STATUS_LINE_OK_LENGTH && isHttpStatusLineOk(pointer)) {
+                memcpy(httpParser->httpVersion, HTTP_STATUS_LINE_OK + HTTP_CONSTANT_NAME_LENGTH, HTTP_VERSION_CHAR_COUNT);
+                httpParser->statusCode = HTTP_OK;
+                onHttpStatusCodeEnd(httpParser);
+                return pointer + HTTP_STATUS_LINE_OK_LENGTH;
+            }
+            return pointer;
+
+        case HTTP_STATE_URI_PATH:     // spans only, byte over length limit is left to per byte path
+            return findHttpCharRanges(pointer, getHttpRequestTargetScanEnd(httpParser, data, pointer, end), &HTTP_URI_PATH_STOP_CHARS);
+
+        case HTTP_STATE_URI_QUERY:
+            return findHttpCharRanges(pointer, getHttpRequestTargetScanEnd(httpParser, data, pointer, end), &HTTP_URI_QUERY_STOP_CHARS);
+
+        case HTTP_STATE_URI_FRAGMENT:
+            return findHttpCharRanges(pointer, getHttpRequestTargetScanEnd(httpParser, data, pointer, end), &HTTP_URI_FRAGMENT_STOP_CHARS);
+
+        case HTTP_STATE_HEADER_NAME:    // per byte only while name can still be one of scanned headers
+            if (scan->headerMatchMask != 0) return pointer;
+            runEnd = findHttpCharRanges(pointer, end, &HTTP_HEADER_NAME_STOP_CHARS);
+            if (IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_HEADER_NAME)) {
+                const char *nameChar = pointer;     // separators and obs-text are not stop chars, per byte path rejects them
+                while (nameChar < runEnd && IS_HTTP_CHAR_CLASS(*nameChar, HTTP_CHAR_TCHAR)) {
+                    nameChar++;
+                }
+                return nameChar;
+            }
+            return runEnd;
+
+        case HTTP_STATE_HEADER_VALUE:
+            if (scan->headerType == HTTP_HEADER_TYPE_CONTENT_LENGTH) return skipHttpContentLengthDigits(httpParser, data, pointer, end);
+            if (scan->headerType != HTTP_HEADER_TYPE_NONE) return pointer;
+            runEnd = findHttpCharRanges(pointer, end, &HTTP_HEADER_VALUE_STOP_CHARS);
+
+            HTTPHeaderSpan *headerSpan = getCurrentHttpHeaderSpan(httpParser);
+            if (headerSpan != NULL) {
+                const char *valueEnd = runEnd;
+                while (valueEnd > pointer && IS_SPACE_OR_TAB(*(valueEnd - 1))) {
+                    valueEnd--;
+                }
+                if (valueEnd > pointer) {
+                    headerSpan->valueLength = httpParser->parsedLength + (uint32_t) (valueEnd - data) - headerSpan->valueOffset;
+                }
+            }
+            return runEnd;
+
+        case HTTP_STATE_SKIP_HEADER_LINE:
+            return findHttpCharRanges(pointer, end, &HTTP_LINE_END_CHARS);
+
+        default:
+            return pointer;
+    }
+}
+
+static inline uint64_t loadHttpWord(const char *pointer) {
+    uint64_t word;
+    memcpy(&word, pointer, sizeof(word));   // unaligned safe, compiled to single load
+    return word;
+}
+
+static inline bool isHttpEightDigits(uint64_t word) {   // little endian word, every byte '0'-'9'
+    return ((word & HTTP_WORD_REPEAT_BYTE(0xF0)) | (((word + HTTP_WORD_REPEAT_BYTE(0x06)) & HTTP_WORD_REPEAT_BYTE(0xF0)) >> 4)) == HTTP_WORD_REPEAT_BYTE(0x33);
+}
+
+static inline uint32_t parseHttpEightDigits(uint64_t word) {    // little endian word, first char is most significant digit
+    word -= HTTP_WORD_REPEAT_BYTE('0');
+    word = word * 10 + (word >> 8);     // pairs of digits
+    word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t) word;
+}
+
+static bool appendHttpEightDigits(uint64_t *value, const char *pointer) {     // false when not digits or sum overflows
+    uint64_t word = HTTP_WORD_TO_LITTLE_ENDIAN(loadHttpWord(pointer));
+    if (!isHttpEightDigits(word)) return false;
+    uint32_t digits = parseHttpEightDigits(word);
+    if (*value > (UINT64_MAX - digits) / HTTP_EIGHT_DIGITS_FACTOR) return false;
+    *value = *value * HTTP_EIGHT_DIGITS_FACTOR + digits;
+    return true;
+}
+
+static bool parseHttpContentLengthValue(const char *value, size_t length, uint64_t *contentLength) {   // only digits, trimmed value
+    uint64_t result = 0;
+    size_t i = 0;
+    while (i + sizeof(uint64_t) <= length && appendHttpEightDigits(&result, value + i)) {
+        i += sizeof(uint64_t);
+    }
+    for (; i < length; i++) {
+        uint8_t digit = value[i] - '0';
+        if (!IS_HTTP_DIGIT(value[i]) || result > (UINT64_MAX - digit) / 10) return false;
+        result = result * 10 + digit;
+    }
+    if (length == 0) return false;
+    *contentLength = result;
+    return true;
+}
+
+static const char *skipHttpContentLengthDigits(HTTPParser *httpParser, const char *data, const char *pointer, const char *end) {
+    if (httpParser->scan.contentLengthState == HTTP_CONTENT_LENGTH_ENDED) return pointer;
+    const char *start = pointer;
+    while (end - pointer >= (long) sizeof(uint64_t) && appendHttpEightDigits(&httpParser->contentLength, pointer)) {
+        pointer += sizeof(uint64_t);
+    }
+    if (pointer > start) {     // non digit, overflow and tail are left to per byte path
+        httpParser->scan.contentLengthState = HTTP_CONTENT_LENGTH_DIGITS;
+        HTTPHeaderSpan *headerSpan = getCurrentHttpHeaderSpan(httpParser);
+        if (headerSpan != NULL) {
+            headerSpan->valueLength = httpParser->parsedLength + (uint32_t) (pointer - data) - headerSpan->valueOffset;
+        }
+    }
+    return pointer;
+}
+
+static const HTTPMethodWord *matchHttpMethodWord(const char *pointer) {     // pointer must have 8 readable bytes
+    uint64_t word = loadHttpWord(pointer);
+    for (uint8_t i = 0; i < sizeof(HTTP_METHOD_WORDS) / sizeof(HTTPMethodWord); i++) {
+        const HTTPMethodWord *methodWord = &HTTP_METHOD_WORDS[i];
+        if ((word & loadHttpWord(methodWord->mask)) == loadHttpWord(methodWord->word)) {
+            return methodWord;
+        }
+    }
+    return NULL;
+}
+
+static bool isHttpStatusLineOk(const char *pointer) {     // pointer must have 13 readable bytes
+    size_t tailOffset = HTTP_STATUS_LINE_OK_LENGTH - sizeof(uint64_t);
+    return loadHttpWord(pointer) == loadHttpWord(HTTP_STATUS_LINE_OK) &&
+           loadHttpWord(pointer + tailOffset) == loadHttpWord(HTTP_STATUS_LINE_OK + tailOffset);
+}
+
+static bool appendHttpVector(HTTPSerializer *serializer, const char *data, size_t length) {
+    if (serializer->count >= serializer->capacity) return false;
+    serializer->vectors[serializer->count].iov_base = (void *) data;     // never written through, writev() takes const data
+    serializer->vectors[serializer->count].iov_len = length;
+    serializer->count++;
+    serializer->length += length;
+    return true;
+}
+
+static bool appendHttpStatusLine(HTTPSerializer *serializer, HTTPStatus statusCode) {
+    for (uint8_t i = 0; i < sizeof(HTTP_STATUS_LINES) / sizeof(HTTPStatusLine); i++) {
+        if (HTTP_STATUS_LINES[i].statusCode == statusCode) {
+            return appendHttpVector(serializer, HTTP_STATUS_LINES[i].line, HTTP_STATUS_LINES[i].length);
+        }
+    }
+
+    serializer->statusCode[0] = (char) ('0' + statusCode / 100);
+    serializer->statusCode[1] = (char) ('0' + statusCode / 10 % 10);
+    serializer->statusCode[2] = (char) ('0' + statusCode % 10);
+    serializer->statusCode[3] = ' ';
+    const char *statusCodeMeaning = getHttpStatusCodeMeaning(statusCode);
+    size_t meaningLength = statusCodeMeaning != NULL ? strlen(statusCodeMeaning) : 0;
+    return isHttpHeaderValueValid(statusCodeMeaning, meaningLength) &&     // reason phrase has field value chars
+           appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_STATUS_LINE_START)) &&
+           appendHttpVector(serializer, serializer->statusCode, HTTP_STATUS_CODE_BUFFER_LENGTH) &&
+           (meaningLength == 0 || appendHttpVector(serializer, statusCodeMeaning, meaningLength)) &&
+           appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_CRLF));
+}
+
+static bool appendHttpHeadersAndBody(HTTPSerializer *serializer, const HTTPOutputHeader *headers, uint16_t headerCount,
+                                     const HTTPBodySegment *body, uint16_t bodyCount) {
+    bool isBodyFramed = false;
+    for (uint16_t i = 0; i < headerCount; i++) {
+        const HTTPOutputHeader *header = &headers[i];
+        const char *name = header->id != HTTP_HEADER_ID_UNKNOWN ? HTTP_HEADER_ID_NAMES[header->id] : header->name;
+        if (name == NULL || header->value == NULL) return false;
+        size_t nameLength = strlen(name);
+        size_t valueLength = strlen(header->value);
+        if (!isHttpHeaderKeyValid(name, nameLength) || !isHttpHeaderValueValid(header->value, valueLength) ||   // no CR/LF injection
+            !appendHttpVector(serializer, name, nameLength) ||
+            !appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_HEADER_NAME_SEPARATOR)) ||
+            !appendHttpVector(serializer, header->value, valueLength) ||
+            !appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_CRLF))) {
+            return false;
+        }
+        HTTPHeaderId headerId = header->id != HTTP_HEADER_ID_UNKNOWN ? header->id : getHttpHeaderId(name, nameLength);
+        isBodyFramed |= headerId == HTTP_HEADER_ID_CONTENT_LENGTH || headerId == HTTP_HEADER_ID_TRANSFER_ENCODING;
+    }
+
+    uint64_t bodyLength = 0;
+    for (uint16_t i = 0; i < bodyCount; i++) {
+        bodyLength += body[i].length;
+    }
+    if (bodyLength > 0 && !isBodyFramed) {
+        char *digits = serializer->contentLength + HTTP_CONTENT_LENGTH_BUFFER_LENGTH;
+        for (uint64_t value = bodyLength; value > 0; value /= 10) {
+            *--digits = (char) ('0' + value % 10);
+        }
+        if (!appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_CONTENT_LENGTH_LINE_START)) ||
+            !appendHttpVector(serializer, digits, serializer->contentLength + HTTP_CONTENT_LENGTH_BUFFER_LENGTH - digits) ||
+            !appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_CRLF))) {
+            return false;
+        }
+    }
+    if (!appendHttpVector(serializer, HTTP_STATIC_VECTOR(HTTP_CRLF))) return false;
+
+    for (uint16_t i = 0; i < bodyCount; i++) {
+        if (body[i].length > 0 && !appendHttpVector(serializer, body[i].data, body[i].length)) return false;
+    }
+    return true;
+}
+
+static uint16_t completeHttpSerializer(HTTPSerializer *serializer, bool isComplete) {     // partial output is never returned
+    if (!isComplete) {
+        serializer->count = 0;
+        serializer->length = 0;
+    }
+    return serializer->count;
+}
+
+static inline uint64_t foldHttpWordCase(uint64_t word) {    // 'A'-'Z' to lower case in all 8 bytes, other bytes kept
+    uint64_t heptets = word & HTTP_WORD_REPEAT_BYTE(0x7F);
+    uint64_t isAtLeastA = heptets + HTTP_WORD_REPEAT_BYTE(0x80 - 'A');
+    uint64_t isAboveZ = heptets + HTTP_WORD_REPEAT_BYTE(0x80 - 'Z' - 1);
+    uint64_t isUpper = isAtLeastA & ~isAboveZ & ~word & HTTP_WORD_REPEAT_BYTE(0x80);
+    return word | (isUpper >> 2);   // 0x80 >> 2 is the 0x20 case bit
+}
+
+static bool isHttpNameEqualIgnoreCase(const char *name, const char *otherName, size_t length) {     // both must have length readable bytes
+    if (length < sizeof(uint64_t)) {
+        for (size_t i = 0; i < length; i++) {
+            if (HTTP_ASCII_LOWER(name[i]) != HTTP_ASCII_LOWER(otherName[i])) return false;
+        }
+        return true;
+    }
+
+    size_t lastWordOffset = length - sizeof(uint64_t);
+    for (size_t i = 0; i < lastWordOffset; i += sizeof(uint64_t)) {
+        if (foldHttpWordCase(loadHttpWord(name + i)) != foldHttpWordCase(loadHttpWord(otherName + i))) return false;
+    }
+    return foldHttpWordCase(loadHttpWord(name + lastWordOffset)) == foldHttpWordCase(loadHttpWord(otherName + lastWordOffset));  // overlapping tail word
+}
+
+static const char *findHttpCharRangesScalar(const char *pointer, const char *end, const HTTPCharRanges *charRanges) {
+    for (; pointer < end; pointer++) {
+        unsigned char ch = *pointer;
+        for (uint8_t i = 0; i < charRanges->length; i += 2) {
+            if (ch >= (unsigned char) charRanges->ranges[i] && ch <= (unsigned char) charRanges->ranges[i + 1]) {
+                return pointer;
+            }
+        }
+    }
+    return end;
+}
+
+#if defined(HTTP_PARSER_X86_DISPATCH)
+__attribute__((target("sse4.2")))
+static const char *findHttpCharRangesSse42(const char *pointer, const char *end, const HTTPCharRanges *charRanges) {
+    __m128i ranges = _mm_loadu_si128((const __m128i *) charRanges->ranges);
+    while (end - pointer >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) pointer);
+        int index = _mm_cmpestri(ranges, charRanges->length, block, 16, _SIDD_LEAST_SIGNIFICANT | _SIDD_CMP_RANGES | _SIDD_UBYTE_OPS);
+        if (index != 16) {
+            return pointer + index;
+        }
+        pointer += 16;
+    }
+    return findHttpCharRangesScalar(pointer, end, charRanges);
+}
+
+__attribute__((target("avx2")))
+static const char *findHttpCharRangesAvx2(const char *pointer, const char *end, const HTTPCharRanges *charRanges) {
+    while (end - pointer >= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) pointer);
+        __m256i match = _mm256_setzero_si256();
+        for (uint8_t i = 0; i < charRanges->length; i += 2) {   // unsigned low <= ch <= high
+            __m256i low = _mm256_set1_epi8(charRanges->ranges[i]);
+            __m256i high = _mm256_set1_epi8(charRanges->ranges[i + 1]);
+            __m256i isAboveLow = _mm256_cmpeq_epi8(_mm256_max_epu8(block, low), block);
+            __m256i isBelowHigh = _mm256_cmpeq_epi8(_mm256_min_epu8(block, high), block);
+            match = _mm256_or_si256(match, _mm256_and_si256(isAboveLow, isBelowHigh));
+        }
+
+        uint32_t matchMask = (uint32_t) _mm256_movemask_epi8(match);
+        if (matchMask != 0) {
+            return pointer + __builtin_ctz(matchMask);
+        }
+        pointer += 32;
+    }
+    return findHttpCharRangesSse42(pointer, end, charRanges);
+}
+
+static void resolveHttpScanImplementation(void) {     // once at load time, before any parsing thread exists
+    setHttpScanImplementation(HTTP_SCAN_AUTO);
+}
+#endif
+
+static bool isHttpScanImplementationSupported(HTTPScanImplementation implementation) {
+#if defined(HTTP_PARSER_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (implementation == HTTP_SCAN_SSE42) return __builtin_cpu_supports("sse4.2");
+    if (implementation == HTTP_SCAN_AVX2) return __builtin_cpu_supports("avx2");
+#endif
+    return implementation == HTTP_SCAN_SCALAR;
+}
+
+static bool isHttpDataBlank(const char *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (!IS_HTTP_WHITESPACE(data[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static char *reserveHttpParserStorage(HTTPParser *httpParser, HTTPParserStorage *storage, size_t size) {
+    if (size > storage->capacity) {
+        HTTPParserAllocator *allocator = &httpParser->allocator;
+        char *data = allocator->reallocate(allocator->context, storage->data, storage->capacity, size);
+        if (data == NULL) return NULL;
+        storage->data = data;
+        storage->capacity = size;
+    }
+    return storage->data;
+}
+
+static char *copyToHttpParserStorage(char *storagePointer, const char *data, size_t length) {
+    memcpy(storagePointer, data, length);
+    storagePointer[length] = '\0';
+    return storagePointer + length + 1;
+}
+
+static char *putHttpHeaderCopy(HTTPParser *httpParser, char *storagePointer, const char *key, size_t keyLength, const char *value, size_t valueLength) {
+    if (isHttpHeaderValid(httpParser, key, keyLength, value, valueLength)) {
+        char *headerKey = storagePointer;
+        char *headerValue = copyToHttpParserStorage(headerKey, key, keyLength);
+        storagePointer = copyToHttpParserStorage(headerValue, value, valueLength);
+        putHttpHeader(httpParser, headerKey, keyLength, headerValue);
+    }
+    return storagePointer;
+}
+
+static const char *nextHttpChunkedRun(HTTPChunkedDecoder *decoder, const char **pointer, const char *end, size_t *runLength) {
+    const char *position = *pointer;
+    while (position < end) {
+        if (decoder->state == HTTP_CHUNKED_STATE_DATA) {
+            size_t available = end - position;
+            *runLength = decoder->chunkRemaining < available ? decoder->chunkRemaining : available;
+            if (*runLength > UINT64_MAX - decoder->bodyLength) {
+                decoder->state = HTTP_CHUNKED_STATE_ERROR;  // total body length overflow
+                break;
+            }
+            decoder->bodyLength += *runLength;
+            decoder->chunkRemaining -= *runLength;
+            if (decoder->chunkRemaining == 0) {
+                decoder->state = HTTP_CHUNKED_STATE_DATA_END;
+            }
+            *pointer = position + *runLength;
+            return position;
+        }
+        if (decoder->state == HTTP_CHUNKED_STATE_DONE || decoder->state == HTTP_CHUNKED_STATE_ERROR) break;
+        onHttpChunkedFramingChar(decoder, *position++);
+    }
+    *pointer = position;
+    return NULL;
+}
+
+static void onHttpChunkedFramingChar(HTTPChunkedDecoder *decoder, char ch) {
+    switch (decoder->state) {
+        case HTTP_CHUNKED_STATE_SIZE:
+            if (IS_HTTP_HEXDIG(ch)) {
+                if (decoder->chunkRemaining > HTTP_CHUNK_SIZE_MAX_BEFORE_DIGIT) {
+                    decoder->state = HTTP_CHUNKED_STATE_ERROR;  // chunk size overflow
+                    return;
+                }
+                decoder->chunkRemaining = (decoder->chunkRemaining << 4) | HTTP_HEXDIG_VALUE(ch);
+                decoder->hasChunkSize = true;
+                return;
+            }
+            if (!decoder->hasChunkSize) {
+                decoder->state = HTTP_CHUNKED_STATE_ERROR;
+                return;
+            }
+            if (ch == ';' || IS_SPACE_OR_TAB(ch)) {
+                decoder->state = HTTP_CHUNKED_STATE_EXTENSION;
+                return;
+            }
+            /* fall through */
+        case HTTP_CHUNKED_STATE_EXTENSION:      // chunk extensions are skipped
+            if (ch == '\r') {
+                decoder->state = HTTP_CHUNKED_STATE_SIZE_LINE_END;
+            } else if (ch == '\n') {
+                decoder->state = decoder->chunkRemaining > 0 ? HTTP_CHUNKED_STATE_DATA : HTTP_CHUNKED_STATE_TRAILER_LINE_START;
+            } else if (decoder->state == HTTP_CHUNKED_STATE_SIZE || (IS_HTTP_CTL(ch) && ch != '\t')) {
+                decoder->state = HTTP_CHUNKED_STATE_ERROR;
+            }
+            return;
+
+        case HTTP_CHUNKED_STATE_SIZE_LINE_END:
+            if (ch != '\n') {
+                decoder->state = HTTP_CHUNKED_STATE_ERROR;
+                return;
+            }
+            decoder->state = decoder->chunkRemaining > 0 ? HTTP_CHUNKED_STATE_DATA : HTTP_CHUNKED_STATE_TRAILER_LINE_START;
+            return;
+
+        case HTTP_CHUNKED_STATE_DATA_END:
+            if (ch == '\r') {
+                decoder->state = HTTP_CHUNKED_STATE_DATA_LINE_END;
+                return;
+            }
+            /* fall through */
+        case HTTP_CHUNKED_STATE_DATA_LINE_END:
+            if (ch != '\n') {
+                decoder->state = HTTP_CHUNKED_STATE_ERROR;
+                return;
+            }
+            decoder->state = HTTP_CHUNKED_STATE_SIZE;
+            decoder->hasChunkSize = false;
+            return;
+
+        case HTTP_CHUNKED_STATE_TRAILER_LINE_START:
+            if (ch == '\r') {
+                decoder->state = HTTP_CHUNKED_STATE_TRAILERS_END;
+            } else if (ch == '\n') {
+                decoder->state = HTTP_CHUNKED_STATE_DONE;
+            } else {
+                decoder->state = HTTP_CHUNKED_STATE_TRAILER_LINE;   // trailer fields are skipped
+            }
+            return;
+
+        case HTTP_CHUNKED_STATE_TRAILER_LINE:
+            if (ch == '\n') {
+                decoder->state = HTTP_CHUNKED_STATE_TRAILER_LINE_START;
+            }
+            return;
+
+        case HTTP_CHUNKED_STATE_TRAILERS_END:
+            decoder->state = ch == '\n' ? HTTP_CHUNKED_STATE_DONE : HTTP_CHUNKED_STATE_ERROR;
+            return;
+
+        default:
+            return;
+    }
+}
+
+static void prefetchHttpBatchMessage(const char *data, size_t length, HTTPParser *httpParser) {
+    if (data != NULL) {
+        HTTP_PREFETCH_READ(data);   // request line and first headers
+        if (length > HTTP_CACHE_LINE_SIZE) {
+            HTTP_PREFETCH_READ(data + HTTP_CACHE_LINE_SIZE);
+        }
+    }
+    HTTP_PREFETCH_WRITE(httpParser);    // fields written by reset
+    HTTP_PREFETCH_WRITE(&httpParser->scan);
+}
+
+static HTTPParserStatus frameHttpMessageBody(HTTPParser *httpParser, const char *data, size_t length) {
+    const char *bodyStart = data + httpParser->messageBodyOffset;
+    const char *end = data + length;
+    HTTPParserStatus status = HTTP_PARSE_OK;
+    if (isMessageBodyNeedToBeSkipped(httpParser)) {
+        httpParser->messageBodyLength = 0;
+    } else if (isHttpBodyChunked(httpParser)) {
+        HTTPChunkedDecoder *decoder = &httpParser->chunkedDecoder;
+        resetHttpChunkedDecoder(decoder);
+        const char *pointer = bodyStart;
+        size_t runLength;
+        while (nextHttpChunkedRun(decoder, &pointer, end, &runLength) != NULL) {}    // payload is skipped, framing only
+        httpParser->messageBodyLength = pointer - bodyStart;
+        status = getHttpChunkedStatus(decoder);
+    } else if (httpParser->contentLength > 0) {
+        httpParser->messageBodyLength = httpParser->contentLength < UINT32_MAX ? httpParser->contentLength : UINT32_MAX;
+        status = httpParser->contentLength <= (size_t) (end - bodyStart) ? HTTP_PARSE_OK : HTTP_PARSE_NEED_MORE_DATA;
+    } else if (httpParser->httpType == HTTP_RESPONSE && (httpParser->scan.seenHeadersMask & HTTP_HEADER_TYPE_BIT(HTTP_HEADER_TYPE_CONTENT_LENGTH)) == 0) {
+        httpParser->messageBodyLength = end - bodyStart;    // body ends with connection close, also when chunked is not final
+    } else {
+        httpParser->messageBodyLength = 0;
+    }
+
+    if (status == HTTP_PARSE_OK) {
+        httpParser->messageLength = httpParser->messageBodyOffset + httpParser->messageBodyLength;
+    }
+    return status;
+}
+
+static HTTPParserStatus getHttpChunkedStatus(const HTTPChunkedDecoder *decoder) {
+    switch (decoder->state) {
+        case HTTP_CHUNKED_STATE_DONE:
+            return HTTP_PARSE_OK;
+        case HTTP_CHUNKED_STATE_ERROR:
+            return HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY;
+        default:
+            return HTTP_PARSE_NEED_MORE_DATA;
+    }
+}
+
+static void *allocateHttpHeap(void *context, size_t size) {
+    (void) context;
+    return malloc(size);
+}
+
+static void *reallocateHttpHeap(void *context, void *pointer, size_t oldSize, size_t newSize) {
+    (void) context;
+    (void) oldSize;
+    return realloc(pointer, newSize);
+}
+
+static void releaseHttpHeap(void *context, void *pointer, size_t size) {
+    (void) context;
+    (void) size;
+    free(pointer);
+}
+
+static void *allocateHttpArena(void *context, size_t size) {
+    HTTPParserArena *arena = context;
+    uintptr_t address = ((uintptr_t) (arena->data + arena->used) + HTTP_ARENA_ALIGNMENT - 1) & ~((uintptr_t) HTTP_ARENA_ALIGNMENT - 1);
+    size_t start = address - (uintptr_t) arena->data;
+    if (start > arena->capacity || size > arena->capacity - start) return NULL;
+    arena->used = start + size;
+    arena->lastAllocation = arena->data + start;
+    return arena->lastAllocation;
+}
+
+static void *reallocateHttpArena(void *context, void *pointer, size_t oldSize, size_t newSize) {
+    HTTPParserArena *arena = context;
+    if (pointer != NULL && pointer == arena->lastAllocation) {    // grow in place at arena end
+        size_t start = arena->lastAllocation - arena->data;
+        if (newSize > arena->capacity - start) return NULL;
+        arena->used = start + newSize;
+        return pointer;
+    }
+
+    void *data = allocateHttpArena(context, newSize);
+    if (data != NULL && pointer != NULL) {
+        memcpy(data, pointer, oldSize < newSize ? oldSize : newSize);
+    }
+    return data;
+}
+
+static void clearHttpHeaders(HTTPParser *httpParser) {
+    if (httpParser->allocator.release != NULL) {     // region allocator fills known and unknown headers only
+        initSingletonHashMap(&httpParser->headers, HTTP_HEADERS_MAP_INITIAL_CAPACITY);
+        hashMapClear(httpParser->headers);
+    }
+    clearHttpKnownHeaders(httpParser);
+    httpParser->unknownHeaderCount = 0;
+}
+
+static void clearHttpParserStrings(HTTPParser *httpParser) {    // version is written as digits only prefix, rest stays zeroed
+    memset(httpParser->httpVersion, 0, strnlen(httpParser->httpVersion, HTTP_VERSION_LENGTH));
+    memset(httpParser->transferEncodingTypes, 0, HTTP_TRANSFER_ENCODING_TYPES_LENGTH);    // value may hold NUL, prefix length is unknown
+}
+
+static void clearHttpKnownHeaders(HTTPParser *httpParser) {
+    for (uint8_t headerId = 0; httpParser->knownHeadersMask != 0; headerId++, httpParser->knownHeadersMask >>= 1) {
+        if (httpParser->knownHeadersMask & 1) {
+            httpParser->knownHeaders[headerId] = NULL;
+        }
+    }
+}
+
+static bool isHttpParserMapAvailable(HTTPParser *httpParser) {     // maps would outlive region reset of parser memory
+    if (httpParser->allocator.release == NULL) {
+        httpParser->parserStatus = HTTP_PARSE_ERROR_MAP_NOT_AVAILABLE;
+        return false;
+    }
+    return true;
+}
+
+static void putHttpHeader(HTTPParser *httpParser, char *key, size_t keyLength, char *value) {
+    if (httpParser->headers != NULL) {
+        hashMapPut(httpParser->headers, key, value);    // spelling from the message, findHttpHeaderValue() ignores case
+    }
+    HTTPHeaderId headerId = getHttpHeaderId(key, keyLength);
+    if (headerId != HTTP_HEADER_ID_UNKNOWN) {
+        httpParser->knownHeaders[headerId] = value;     // last one wins, same as "headers" map
+        httpParser->knownHeadersMask |= (uint64_t) 1 << headerId;
+        return;
+    }
+
+    if (httpParser->unknownHeaderCount == httpParser->unknownHeaderCapacity) {
+        uint16_t capacity = httpParser->unknownHeaderCapacity == 0 ? HTTP_UNKNOWN_HEADERS_INITIAL_CAPACITY : httpParser->unknownHeaderCapacity * 2;
+        HTTPParserAllocator *allocator = &httpParser->allocator;
+        HTTPHeaderEntry *unknownHeaders = allocator->reallocate(allocator->context, httpParser->unknownHeaders,
+                                                                httpParser->unknownHeaderCapacity * sizeof(HTTPHeaderEntry), capacity * sizeof(HTTPHeaderEntry));
+        if (unknownHeaders == NULL) return;     // still available from "headers" map
+        httpParser->unknownHeaders = unknownHeaders;
+        httpParser->unknownHeaderCapacity = capacity;
+    }
+    httpParser->unknownHeaders[httpParser->unknownHeaderCount++] = (HTTPHeaderEntry) {key, value};
+}
+
+static bool decodeHttpPercentEscape(const char *pointer, const char *end, char *decoded) {   // pointer at '%'
+    if (end - pointer < 3 || !IS_HTTP_HEXDIG(pointer[1]) || !IS_HTTP_HEXDIG(pointer[2])) return false;  // truncated or non hex
+    *decoded = (char) (HTTP_HEXDIG_VALUE(pointer[1]) << 4 | HTTP_HEXDIG_VALUE(pointer[2]));
+    return true;
+}
+
+static char *removeHttpDotSegment(char *buffer, char *segmentStart, char *segmentEnd) {    // RFC 3986 5.2.4 for last written segment
+    size_t segmentLength = segmentEnd - segmentStart;
+    if (segmentLength == 1 && segmentStart[0] == '.') {
+        return segmentStart;
+    } else if (segmentLength == 2 && segmentStart[0] == '.' && segmentStart[1] == '.') {
+        char *output = segmentStart - 1;    // slash before ".."
+        while (output > buffer && output[-1] != '/') {
+            output--;
+        }
+        return output > buffer ? output : buffer + 1;   // never above root
+    }
+    return segmentEnd;
+}
+
+// Returns matched line, or where the scan stopped: empty line, end of data or NULL for incomplete header block.
+// Never reads at or past "end". Name followed by whitespace before colon is returned with empty span, caller rejects the message
+static const char *findHttpHeaderLine(const char *messageBuffer, const char *line, const char *end, const char *name, HTTPHeaderSpan *headerSpan) {
+    size_t nameLength = strlen(name);
+    while (line < end && !IS_LINE_END(*line)) {
+        const char *lineEnd = memchr(line, '\n', end - line);
+        const char *dataEnd = lineEnd != NULL ? lineEnd : end;
+        size_t lineLength = dataEnd - line;
+        if (lineLength > nameLength && HTTP_ASCII_LOWER(*line) == HTTP_ASCII_LOWER(*name) && isHttpNameEqualIgnoreCase(line, name, nameLength)) {
+            const char *valueStart = line + nameLength;
+            if (IS_SPACE_OR_TAB(*valueStart)) {
+                const char *colon = valueStart;
+                while (colon < dataEnd && IS_SPACE_OR_TAB(*colon)) {
+                    colon++;
+                }
+                if (colon < dataEnd && *colon == ':') return line;
+            }
+
+            if (*valueStart == ':') {
+                const char *valueEnd = dataEnd;
+                valueStart++;
+                if (valueEnd > valueStart && *(valueEnd - 1) == '\r') {
+                    valueEnd--;
+                }
+                trimHttpSpan(&valueStart, &valueEnd);
+                headerSpan->nameOffset = line - messageBuffer;
+                headerSpan->nameLength = nameLength;
+                headerSpan->valueOffset = valueStart - messageBuffer;
+                headerSpan->valueLength = valueEnd - valueStart;
+                return line;
+            }
+        }
+        if (lineEnd == NULL) return NULL;
+        line = lineEnd + 1;
+    }
+    return line;
+}
+
+static bool isHttpHeaderLineMalformed(const char *line, const char *end, const HTTPHeaderSpan *headerSpan) {
+    return line != NULL && line < end && headerSpan->nameLength == 0 && !IS_LINE_END(*line);
+}
+
+static void trimHttpSpan(const char **start, const char **end) {
+    while (*start < *end && IS_SPACE_OR_TAB(**start)) {
+        (*start)++;
+    }
+    while (*end > *start && IS_SPACE_OR_TAB(*(*end - 1))) {
+        (*end)--;
+    }
+}
+
+static bool isHttpHeaderValid(const HTTPParser *httpParser, const char *headerKey, size_t keyLength, const char *headerValue, size_t valueLength) {
+    if (headerKey == NULL || keyLength == 0) return false;     // delimiters are checked by every profile
+    return (!IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_HEADER_NAME) || isHttpHeaderKeyValid(headerKey, keyLength)) &&
+           (!IS_HTTP_CHECK_ENABLED(httpParser, HTTP_CHECK_HEADER_VALUE) || isHttpHeaderValueValid(headerValue, valueLength));
+}
+
+static bool isHttpHeaderKeyValid(const char *headerKey, size_t length) {
+    if (headerKey == NULL || length == 0) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (!IS_HTTP_CHAR_CLASS(headerKey[i], HTTP_CHAR_TCHAR)) {
+            return false;
+        }
+    }
+    return true;
 }
 
-static bool isHttpHeaderKeyValid(const char *headerKey) {
-    if (isStringBlank(headerKey)) return false;
-    while (*headerKey != '\0') {
-        if (iscntrl(*headerKey) || *headerKey == '/' || *headerKey == '{') {
+static bool isHttpHeaderValueValid(const char *headerValue, size_t length) {
+    if (headerValue == NULL || length == 0) return true;    // blank value is checked too, "\r\n" is blank
+    for (size_t i = 0; i < length; i++) {
+        if (!IS_HTTP_CHAR_CLASS(headerValue[i], HTTP_CHAR_FIELD_VALUE)) {
             return false;
         }
-        headerKey++;
     }
     return true;
 }
 
-static bool isHttpHeaderValueValid(const char *headerValue) {
-    if (isStringBlank(headerValue)) return true;
-    while (*headerValue != '\0') {
-        if (iscntrl(*headerValue)) {
+static bool isHttpRequestTargetValid(const char *target, size_t length) {
+    if (target == NULL || length == 0) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (IS_HTTP_CTL(target[i]) || target[i] == ' ') {
             return false;
         }
-        headerValue++;
     }
     return true;
 }
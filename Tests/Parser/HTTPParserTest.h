@@ -33,6 +33,11 @@ static const char *testResponse =
 
 static HTTPParser *parser = NULL;
 
+#define assert_http_uri_path(httpParser, messageBuffer, expected) do { \
+        assert_int((httpParser)->requestTarget.pathLength, ==, strlen(expected)); \
+        assert_memory_equal(strlen(expected), (const char *) (messageBuffer) + (httpParser)->requestTarget.pathOffset, expected); \
+    } while (0)
+
 static void *httpParserSetup(const MunitParameter params[], void *userData) {
     char *httpDataBuffer = malloc(2500);
     assert_not_null(httpDataBuffer);
@@ -62,7 +67,7 @@ static MunitResult multilineSpacesHttpOk(const MunitParameter params[], void *ht
     assert_int(parser->method, ==, HTTP_GET);
     assert_string_equal(parser->messageBody, "");
     assert_string_equal(parser->httpVersion, "1.0");
-    assert_string_equal(parser->uriPath, "/");
+    assert_http_uri_path(parser, httpDataBuffer, "/");
     return MUNIT_OK;
 }
 
@@ -110,17 +115,17 @@ static MunitResult parseMultiLineValueHeaderHttpOk(const MunitParameter params[]
     return MUNIT_OK;
 }
 
-static MunitResult parseHeaderWithTrailingSpaceHttpOk(const MunitParameter params[], void *httpDataBuffer) {
+static MunitResult parseHeaderWithSpaceBeforeColonHttpError(const MunitParameter params[], void *httpDataBuffer) {
     strcpy(httpDataBuffer, "GET / HTTP/1.0\r\nfoo : ab\r\n\r\n");
     parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
     assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
     assert_int(parser->method, ==, HTTP_GET);
     assert_string_equal(parser->httpVersion, "1.0");
 
-    parseHttpHeaders(parser, httpDataBuffer);
+    parseHttpHeaders(parser, httpDataBuffer);   // whitespace before colon is rejected, RFC 9112 5.1
     HashMap headers = parser->headers;
-    assert_int(getHashMapSize(headers), ==, 1);
-    assert_string_equal(hashMapGet(headers, "foo"), "ab");
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_HEADER);
+    assert_int(getHashMapSize(headers), ==, 0);
     return MUNIT_OK;
 }
 
@@ -131,7 +136,7 @@ static MunitResult parseHttpRequestOk(const MunitParameter params[], void *httpD
     assert_string_equal(parser->httpVersion, "1.1");
     assert_int(parser->contentLength, ==, 12345);
     assert_int(parser->method, ==, HTTP_POST);
-    assert_string_equal(parser->uriPath, "/cgi-bin/process.cgi");
+    assert_http_uri_path(parser, httpDataBuffer, "/cgi-bin/process.cgi");
     assert_string_equal(parser->messageBody, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<string xmlns=\"http://clearforest.com/\">string</string>");
     assert_string_equal(parser->transferEncodingTypes, "");
 
@@ -330,6 +335,1240 @@ static MunitResult checkInvalidHttpResponse(const MunitParameter params[], void
     return MUNIT_OK;
 }
 
+// SINGLE-PASS ENGINE
+static MunitResult parseHttpMessageRequestOk(const MunitParameter params[], void *httpDataBuffer) {
+    strcpy(httpDataBuffer, testRequest);
+    parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_string_equal(parser->httpVersion, "1.1");
+    assert_int(parser->contentLength, ==, 12345);
+    assert_int(parser->method, ==, HTTP_POST);
+    assert_http_uri_path(parser, httpDataBuffer, "/cgi-bin/process.cgi");
+    assert_string_equal(parser->messageBody, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<string xmlns=\"http://clearforest.com/\">string</string>");
+    assert_string_equal(parser->transferEncodingTypes, "");
+
+    assert_int(parser->headersStartOffset, ==, strlen("POST /cgi-bin/process.cgi HTTP/1.1\n"));
+    assert_memory_equal(strlen("User-Agent"), (char *) httpDataBuffer + parser->headersStartOffset, "User-Agent");
+    assert_int(parser->headersEndOffset + 1, ==, parser->messageBodyOffset);
+    assert_ptr_equal(parser->messageBody, (char *) httpDataBuffer + parser->messageBodyOffset);
+    return MUNIT_OK;
+}
+
+static MunitResult parseHttpMessageResponseOk(const MunitParameter params[], void *httpDataBuffer) {
+    strcpy(httpDataBuffer, testResponse);
+    parseHttpMessage(httpDataBuffer, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_string_equal(parser->httpVersion, "1.1");
+    assert_int(parser->statusCode, ==, HTTP_BAD_REQUEST);
+    assert_string_equal(parser->transferEncodingTypes, "gzip");
+    assert_string_equal(parser->messageBody, "<html>\r\n<head><title>400 Bad Request</title></head>\r\n<body>\r\n<center><h1>400 Bad Request</h1></center>\r\n</body>\r\n</html>\r\n");
+
+    strcpy(httpDataBuffer, "HTTP/1.1   200 \t  OK \t\r\nfoo: \r\nfoo: b\r\n  \tc\r\n\r\n");
+    parseHttpMessage(httpDataBuffer, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->statusCode, ==, HTTP_OK);
+    assert_string_equal(parser->messageBody, "");
+    return MUNIT_OK;
+}
+
+static MunitResult parseHttpMessageSameAsParseHttpBuffer(const MunitParameter params[], void *httpDataBuffer) {
+    const char *httpMessage = munit_parameters_get(params, "httpMessage");
+    HTTPParserType httpType = strncmp(httpMessage, "HTTP/", 5) == 0 ? HTTP_RESPONSE : HTTP_REQUEST;
+    HTTPParser *singlePassParser = getHttpParserInstance();
+
+    strcpy(httpDataBuffer, httpMessage);
+    parseHttpMessage(httpDataBuffer, singlePassParser, httpType);
+    parseHttpBuffer(httpDataBuffer, parser, httpType);
+    assert_int(singlePassParser->parserStatus, ==, parser->parserStatus);
+    if (parser->parserStatus != HTTP_PARSE_OK) {    // engines stop at the first error, field state may differ
+        deleteHttpParser(singlePassParser);
+        return MUNIT_OK;
+    }
+    assert_string_equal(singlePassParser->httpVersion, parser->httpVersion);
+    assert_memory_equal(sizeof(HTTPRequestTarget), &singlePassParser->requestTarget, &parser->requestTarget);
+    assert_string_equal(singlePassParser->transferEncodingTypes, parser->transferEncodingTypes);
+    assert_int(singlePassParser->contentLength, ==, parser->contentLength);
+    assert_int(singlePassParser->method, ==, parser->method);
+    assert_int(singlePassParser->statusCode, ==, parser->statusCode);
+    assert_ptr_equal(singlePassParser->messageBody, parser->messageBody);
+    deleteHttpParser(singlePassParser);
+    return MUNIT_OK;
+}
+
+// INCREMENTAL FEED
+static MunitResult httpParserFeedByteByByteOk(const MunitParameter params[], void *httpDataBuffer) {
+    strcpy(httpDataBuffer, testResponse);
+    const char *data = httpDataBuffer;
+    size_t headLength = strstr(data, "\r\n\r\n") + 4 - data;
+
+    resetHttpParser(parser, HTTP_RESPONSE);
+    for (size_t i = 0; i < headLength - 1; i++) {
+        assert_int(httpParserFeed(parser, data + i, 1), ==, HTTP_PARSE_NEED_MORE_DATA);
+        assert_int(parser->parsedLength, ==, i + 1);
+    }
+    assert_int(httpParserFeed(parser, data + headLength - 1, strlen(data) - headLength + 1), ==, HTTP_PARSE_OK);
+    assert_int(parser->parsedLength, ==, headLength);
+    assert_int(parser->messageBodyOffset, ==, headLength);
+    assert_ptr_equal(parser->messageBody, data + headLength);
+    assert_string_equal(parser->httpVersion, "1.1");
+    assert_int(parser->statusCode, ==, HTTP_BAD_REQUEST);
+    assert_string_equal(parser->transferEncodingTypes, "gzip");
+
+    assert_int(httpParserFeed(parser, "GET / HTTP/1.1\r\n\r\n", 18), ==, HTTP_PARSE_OK);   // already done, nothing consumed
+    assert_int(parser->parsedLength, ==, headLength);
+    return MUNIT_OK;
+}
+
+static MunitResult httpParserFeedChunksOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *chunks[] = {"POST /cgi-bin/proc", "ess.cgi HTTP/1.1\r\nContent-Len", "gth: 12", "345\r", "\nAccept-Encoding: gzip\r\n\r", "\nhello"};
+    resetHttpParser(parser, HTTP_REQUEST);
+    for (uint32_t i = 0; i < ARRAY_SIZE(chunks) - 1; i++) {
+        assert_int(httpParserFeed(parser, chunks[i], strlen(chunks[i])), ==, HTTP_PARSE_NEED_MORE_DATA);
+    }
+    assert_int(httpParserFeed(parser, chunks[5], strlen(chunks[5])), ==, HTTP_PARSE_OK);
+    assert_int(parser->method, ==, HTTP_POST);
+    assert_int(parser->requestTarget.pathOffset, ==, strlen("POST "));
+    assert_int(parser->requestTarget.pathLength, ==, strlen("/cgi-bin/process.cgi"));
+    assert_int(parser->contentLength, ==, 12345);
+    assert_string_equal(parser->messageBody, "hello");
+    return MUNIT_OK;
+}
+
+static MunitResult httpParserFeedMalformedFail(const MunitParameter params[], void *httpDataBuffer) {
+    resetHttpParser(parser, HTTP_REQUEST);
+    assert_int(httpParserFeed(parser, "GET / HT", 8), ==, HTTP_PARSE_NEED_MORE_DATA);
+    assert_int(httpParserFeed(parser, "kP/1.1\r\n\r\n", 10), ==, HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT);
+    assert_int(httpParserFeed(parser, "\r\n", 2), ==, HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT);
+    return MUNIT_OK;
+}
+
+// LENGTH BOUNDED, READ ONLY INPUT
+static MunitResult parseHttpBufferNReadOnlyOk(const MunitParameter params[], void *httpDataBuffer) {
+    parseHttpBufferN(testRequest, strlen(testRequest), parser, HTTP_REQUEST);  // string literal, any write would crash
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->method, ==, HTTP_POST);
+    assert_http_uri_path(parser, testRequest, "/cgi-bin/process.cgi");
+    assert_int(parser->contentLength, ==, 12345);
+    assert_ptr_equal(parser->messageBody, testRequest + parser->messageBodyOffset);
+
+    parseHttpHeadersN(parser, testRequest, strlen(testRequest));
+    HashMap headers = parser->headers;
+    assert_int(getHashMapSize(headers), ==, 7);
+    assert_string_equal(hashMapGet(headers, "User-Agent"), "Mozilla/4.0 (compatible; MSIE5.01; Windows NT)");
+    assert_string_equal(hashMapGet(headers, "Content-Type"), "text/xml; charset=utf-8");
+    assert_string_equal(hashMapGet(headers, "Connection"), "Keep-Alive");
+
+    const char *url = "/api/user?id=1&test=1245&utm=value&=skip&flag HTTP/1.1";
+    parseHttpQueryParametersN(parser, url, strlen(url));
+    assert_int(getHashMapSize(parser->queryParameters), ==, 3);
+    assert_string_equal(hashMapGet(parser->queryParameters, "id"), "1");
+    assert_string_equal(hashMapGet(parser->queryParameters, "test"), "1245");
+    assert_string_equal(hashMapGet(parser->queryParameters, "utm"), "value");
+    return MUNIT_OK;
+}
+
+static MunitResult parseHttpBufferNLengthBoundOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *response = "HTTP/1.1 200 OK\r\nHost: example.com\r\nfoo: ab\r\n\r\nGARBAGE";
+    size_t headLength = strstr(response, "\r\n\r\n") + 4 - response;
+    parseHttpBufferN(response, headLength - 1, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_LINE_SEPARATORS);
+    parseHttpBufferN(response, headLength, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->statusCode, ==, HTTP_OK);
+    parseHttpBufferN(response, 0, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_EMPTY_DATA);
+
+    parseHttpHeadersN(parser, response, headLength - 6);   // last header line is cut
+    assert_int(getHashMapSize(parser->headers), ==, 1);
+    assert_string_equal(hashMapGet(parser->headers, "Host"), "example.com");
+    parseHttpHeadersN(parser, response, headLength);
+    assert_int(getHashMapSize(parser->headers), ==, 2);
+    assert_string_equal(hashMapGet(parser->headers, "foo"), "ab");
+
+    const char *url = "/test?key=value&next=1";
+    parseHttpQueryParametersN(parser, url, strlen("/test?key=va"));
+    assert_int(getHashMapSize(parser->queryParameters), ==, 1);
+    assert_string_equal(hashMapGet(parser->queryParameters, "key"), "va");
+    return MUNIT_OK;
+}
+
+static MunitResult parseMalformedHeadersNFail(const MunitParameter params[], void *httpDataBuffer) {
+    const char *malformedHeaders[] = {":a", " :a", "a\0b: c", "ab: c\0d", "a\033b: c", "ab: c\033", "/: 1", "{: 1", "no colon", "a b: c", "\xe3\x81: c", "a\x7f: c"};
+    const size_t malformedHeaderLengths[] = {2, 3, 6, 7, 6, 6, 4, 4, 8, 6, 5, 5};
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(malformedHeaders); i++) {
+        char *pointer = httpDataBuffer;
+        pointer += sprintf(pointer, "GET / HTTP/1.1\r\n");
+        memcpy(pointer, malformedHeaders[i], malformedHeaderLengths[i]);
+        pointer += malformedHeaderLengths[i];
+        memcpy(pointer, HTTP_LINE_SEPARATOR, 4);
+        pointer += 4;
+
+        parseHttpHeadersN(parser, httpDataBuffer, pointer - (char *) httpDataBuffer);
+        assert_true(isHashMapEmpty(parser->headers));
+    }
+    return MUNIT_OK;
+}
+static MunitResult parseHeadersNCharClassesOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *request = "GET / HTTP/1.1\r\n!#$%&'*+-.^_`|~09azAZ: \x80\xff\tvalue \"(),/:;<=>?@[\\]{}\r\n\r\n";
+    parseHttpHeadersN(parser, request, strlen(request));
+    assert_int(getHashMapSize(parser->headers), ==, 1);
+    assert_string_equal(hashMapGet(parser->headers, "!#$%&'*+-.^_`|~09azAZ"), "\x80\xff\tvalue \"(),/:;<=>?@[\\]{}");
+    return MUNIT_OK;
+}
+
+// HEADER INDEX
+static MunitResult httpHeaderIndexOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *request = "GET /hoge HTTP/1.1\r\nHost: example.com\r\nCookie: \r\nfoo:  ab  \r\n  \tc\r\nno colon\r\nAccept: */*\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->headerCount, ==, 4);
+
+    const HTTPHeaderSpan *host = findHttpHeaderSpan(parser, request, "Host");
+    assert_not_null(host);
+    assert_memory_equal(host->valueLength, request + host->valueOffset, "example.com");
+    assert_int(host->valueLength, ==, strlen("example.com"));
+    const HTTPHeaderSpan *cookie = findHttpHeaderSpan(parser, request, "Cookie");
+    assert_not_null(cookie);
+    assert_int(cookie->valueLength, ==, 0);
+    const HTTPHeaderSpan *foo = findHttpHeaderSpan(parser, request, "foo");
+    assert_not_null(foo);
+    assert_memory_equal(foo->valueLength, request + foo->valueOffset, "ab");
+    assert_int(foo->valueLength, ==, 2);
+    assert_null(findHttpHeaderSpan(parser, request, "Hos"));
+    assert_null(findHttpHeaderSpan(parser, request, "Content-Length"));
+
+    const char *expectedNames[] = {"Host", "Cookie", "foo", "Accept"};
+    uint32_t index = 0;
+    HTTPHeaderIterator iterator = getHttpHeaderIterator(parser, request);
+    while (httpHeaderHasNext(&iterator)) {
+        assert_int(iterator.nameLength, ==, strlen(expectedNames[index]));
+        assert_memory_equal(iterator.nameLength, iterator.name, expectedNames[index]);
+        index++;
+    }
+    assert_int(index, ==, 4);
+
+    parseHttpHeadersFromIndex(parser, request);
+    assert_int(getHashMapSize(parser->headers), ==, 4);
+    assert_string_equal(hashMapGet(parser->headers, "Host"), "example.com");
+    assert_string_equal(hashMapGet(parser->headers, "Cookie"), "");
+    assert_string_equal(hashMapGet(parser->headers, "foo"), "ab");
+    assert_string_equal(hashMapGet(parser->headers, "Accept"), "*/*");
+    return MUNIT_OK;
+}
+
+static MunitResult httpHeaderIndexOverflowOk(const MunitParameter params[], void *httpDataBuffer) {
+    char *pointer = httpDataBuffer;
+    pointer += sprintf(pointer, "GET / HTTP/1.1\r\n");
+    for (uint32_t i = 0; i < HTTP_HEADER_INDEX_CAPACITY + 5; i++) {
+        pointer += sprintf(pointer, "X-Header-%u: %u\r\n", i, i);
+    }
+    strcpy(pointer, "\r\n");
+
+    parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->headerCount, ==, HTTP_HEADER_INDEX_CAPACITY + 5);
+    assert_not_null(findHttpHeaderSpan(parser, httpDataBuffer, "X-Header-0"));
+    assert_null(findHttpHeaderSpan(parser, httpDataBuffer, "X-Header-35"));
+
+    parseHttpHeadersFromIndex(parser, httpDataBuffer);
+    assert_int(getHashMapSize(parser->headers), ==, HTTP_HEADER_INDEX_CAPACITY);
+    return MUNIT_OK;
+}
+
+// VECTORIZED SCANNING
+static MunitResult longTokensAnyChunkSize(void) {
+    const char *request =
+            "GET /very/long/path/that/does/not/fit/one/vector/register.html?query=with&some=parameters&to=skip HTTP/1.1\r\n"
+            "X-Very-Long-Header-Name-Above-Thirty-Two-Bytes: value that is longer than a single AVX2 register, \x80\xff obs-text  \t \r\n"
+            "Host: example.com\r\n"
+            "Transfer-Encoding: gzip, chunked\r\n"
+            "\r\n";
+    size_t length = strlen(request);
+    parseHttpBufferN(request, length, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    HTTPParser expected = *parser;
+    assert_http_uri_path(&expected, request, "/very/long/path/that/does/not/fit/one/vector/register.html");
+    assert_memory_equal(expected.requestTarget.queryLength, request + expected.requestTarget.queryOffset, "query=with&some=parameters&to=skip");
+    assert_memory_equal(expected.headerIndex[0].valueLength, request + expected.headerIndex[0].valueOffset, "value that is longer than a single AVX2 register, \x80\xff obs-text");
+
+    for (size_t chunkSize = 1; chunkSize <= length; chunkSize++) {
+        resetHttpParser(parser, HTTP_REQUEST);
+        for (size_t position = 0; position < length; position += chunkSize) {
+            size_t remaining = length - position;
+            httpParserFeed(parser, request + position, remaining < chunkSize ? remaining : chunkSize);
+        }
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_memory_equal(sizeof(HTTPRequestTarget), &parser->requestTarget, &expected.requestTarget);
+        assert_string_equal(parser->transferEncodingTypes, "gzip, chunked");
+        assert_int(parser->headerCount, ==, expected.headerCount);
+        assert_memory_equal(sizeof(HTTPHeaderSpan) * expected.headerCount, parser->headerIndex, expected.headerIndex);
+    }
+
+    char longPath[100] = "GET /";
+    memset(longPath + 5, 'a', 63);
+    strcpy(longPath + 5 + 63, " HTTP/1.1\r\n\r\n");
+    parser->maxRequestTargetLength = 64;
+    parseHttpBufferN(longPath, strlen(longPath), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->requestTarget.pathLength, ==, 64);
+    longPath[68] = 'a';     // one over limit
+    parseHttpBufferN(longPath, strlen(longPath), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_URI_PATH_TOO_LONG);
+    parser->maxRequestTargetLength = HTTP_REQUEST_TARGET_MAX_LENGTH;
+    return MUNIT_OK;
+}
+
+static MunitResult longTokensAnyChunkSizeOk(const MunitParameter params[], void *httpDataBuffer) {
+    return longTokensAnyChunkSize();
+}
+
+static MunitResult scanImplementationsSameResultOk(const MunitParameter params[], void *httpDataBuffer) {
+    HTTPScanImplementation implementations[] = {HTTP_SCAN_SCALAR, HTTP_SCAN_SSE42, HTTP_SCAN_AVX2};
+    for (uint32_t i = 0; i < ARRAY_SIZE(implementations); i++) {
+        if (setHttpScanImplementation(implementations[i])) {
+            assert_int(getHttpScanImplementation(), ==, implementations[i]);
+            assert_int(longTokensAnyChunkSize(), ==, MUNIT_OK);
+        }
+    }
+    assert_true(setHttpScanImplementation(HTTP_SCAN_SCALAR));
+
+    setenv("HTTP_PARSER_FORCE_SCALAR", "1", 1);
+    assert_true(setHttpScanImplementation(HTTP_SCAN_AUTO));
+    assert_int(getHttpScanImplementation(), ==, HTTP_SCAN_SCALAR);
+    unsetenv("HTTP_PARSER_FORCE_SCALAR");
+    assert_true(setHttpScanImplementation(HTTP_SCAN_AUTO));
+    assert_int(getHttpScanImplementation(), !=, HTTP_SCAN_AUTO);
+    return MUNIT_OK;
+}
+
+static MunitResult httpMethodWordOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *methods[] = {"GET", "POST", "PUT", "DELETE", "HEAD", "OPTIONS", "PATCH", "CONNECT", "TRACE"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(methods); i++) {
+        sprintf(httpDataBuffer, "%s / HTTP/1.1\r\n\r\n", methods[i]);
+        parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_int(parser->method, ==, getHttpMethodByName(methods[i]));
+        assert_http_uri_path(parser, httpDataBuffer, "/");
+
+        parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_int(parser->method, ==, getHttpMethodByName(methods[i]));
+    }
+
+    strcpy(httpDataBuffer, "GETS / HTTP/1.1\r\n\r\n");  // prefix of known method is not a match
+    parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_NO_SUCH_HTTP_METHOD);
+
+    strcpy(httpDataBuffer, "\r\nPUT\t/ HTTP/1.1\r\n\r\n");  // tab separator takes byte path
+    parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->method, ==, HTTP_PUT);
+
+    resetHttpParser(parser, HTTP_REQUEST);  // method split across chunks
+    assert_int(httpParserFeed(parser, "DEL", 3), ==, HTTP_PARSE_NEED_MORE_DATA);
+    assert_int(httpParserFeed(parser, "ETE / HTTP/1.1\r\n\r\n", 18), ==, HTTP_PARSE_OK);
+    assert_int(parser->method, ==, HTTP_DELETE);
+    return MUNIT_OK;
+}
+
+static MunitResult knownHeaderIdsOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *names[] = {"Accept", "Accept-Charset", "Accept-Encoding", "Accept-Language", "Accept-Ranges", "Age", "Allow",
+                           "Authorization", "Cache-Control", "Connection", "Content-Disposition", "Content-Encoding", "Content-Language",
+                           "Content-Length", "Content-Location", "Content-Range", "Content-Type", "Cookie", "Date", "ETag", "Expect",
+                           "Expires", "Forwarded", "From", "Host", "If-Match", "If-Modified-Since", "If-None-Match", "If-Range",
+                           "If-Unmodified-Since", "Keep-Alive", "Last-Modified", "Location", "Origin", "Pragma", "Proxy-Authorization",
+                           "Range", "Referer", "Server", "Set-Cookie", "TE", "Trailer", "Transfer-Encoding", "Upgrade", "User-Agent",
+                           "Vary", "Via", "WWW-Authenticate", "X-Forwarded-For"};
+    bool isIdTaken[HTTP_HEADER_ID_COUNT] = {0};
+    for (uint32_t i = 0; i < ARRAY_SIZE(names); i++) {
+        HTTPHeaderId headerId = getHttpHeaderId(names[i], strlen(names[i]));
+        assert_int(headerId, !=, HTTP_HEADER_ID_UNKNOWN);
+        assert_false(isIdTaken[headerId]);
+        isIdTaken[headerId] = true;
+    }
+    assert_int(ARRAY_SIZE(names), ==, HTTP_HEADER_ID_COUNT - 1);
+    assert_int(getHttpHeaderId("Host", 4), ==, HTTP_HEADER_ID_HOST);
+    assert_int(getHttpHeaderId("Hosts", 5), ==, HTTP_HEADER_ID_UNKNOWN);
+    assert_int(getHttpHeaderId("Hoxt", 4), ==, HTTP_HEADER_ID_UNKNOWN);
+    assert_int(getHttpHeaderId("X-Custom", 8), ==, HTTP_HEADER_ID_UNKNOWN);
+    assert_int(getHttpHeaderId("", 0), ==, HTTP_HEADER_ID_UNKNOWN);
+
+    strcpy(httpDataBuffer, testRequest);
+    parseHttpHeaders(parser, httpDataBuffer);
+    assert_string_equal(parser->knownHeaders[HTTP_HEADER_ID_HOST], "www.example.com");
+    assert_string_equal(parser->knownHeaders[HTTP_HEADER_ID_CONTENT_TYPE], "text/xml; charset=utf-8");
+    assert_string_equal(parser->knownHeaders[HTTP_HEADER_ID_CONNECTION], "Keep-Alive");
+    assert_ptr_equal(parser->knownHeaders[HTTP_HEADER_ID_HOST], hashMapGet(parser->headers, "Host"));
+    assert_null(parser->knownHeaders[HTTP_HEADER_ID_AUTHORIZATION]);
+    assert_int(parser->unknownHeaderCount, ==, 0);
+
+    const char *request = "GET / HTTP/1.1\r\nHost: a.com\r\nX-Request-Id: 42\r\nX-Trace: on\r\n\r\n";
+    parseHttpHeadersN(parser, request, strlen(request));
+    assert_string_equal(parser->knownHeaders[HTTP_HEADER_ID_HOST], "a.com");
+    assert_null(parser->knownHeaders[HTTP_HEADER_ID_CONNECTION]);     // cleared from previous parse
+    assert_int(parser->unknownHeaderCount, ==, 2);
+    assert_string_equal(parser->unknownHeaders[0].name, "X-Request-Id");
+    assert_string_equal(parser->unknownHeaders[0].value, "42");
+    assert_string_equal(parser->unknownHeaders[1].name, "X-Trace");
+    assert_string_equal(parser->unknownHeaders[1].value, "on");
+    return MUNIT_OK;
+}
+
+static MunitResult decodeHttpChunkedOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *chunkedBody = "4\r\nWiki\r\n5;name=value\r\npedia\r\nE\r\n in\r\n\r\nchunks.\r\n0\r\nExpires: never\r\n\r\nGET /next";
+    const char *decodedBody = "Wikipedia in\r\n\r\nchunks.";
+    HTTPChunkedDecoder decoder;
+    resetHttpChunkedDecoder(&decoder);
+    strcpy(httpDataBuffer, chunkedBody);
+    assert_int(decodeHttpChunked(&decoder, httpDataBuffer, strlen(chunkedBody)), ==, HTTP_PARSE_OK);
+    assert_int(decoder.bodyLength, ==, strlen(decodedBody));
+    assert_memory_equal(decoder.bodyLength, httpDataBuffer, decodedBody);
+    assert_int(decoder.consumedLength, ==, strlen(chunkedBody) - strlen("GET /next"));
+
+    char decoded[64] = {0};     // byte by byte, payload collected by caller
+    uint32_t decodedLength = 0;
+    resetHttpChunkedDecoder(&decoder);
+    for (uint32_t i = 0; i < strlen(chunkedBody) - strlen("GET /next"); i++) {
+        char ch = chunkedBody[i];
+        HTTPParserStatus status = decodeHttpChunked(&decoder, &ch, 1);
+        assert_int(status, ==, i + 1 < strlen(chunkedBody) - strlen("GET /next") ? HTTP_PARSE_NEED_MORE_DATA : HTTP_PARSE_OK);
+        if (decoder.decodedLength > 0) {
+            decoded[decodedLength++] = ch;
+        }
+    }
+    assert_string_equal(decoded, decodedBody);
+
+    HTTPBodySpan spans[2];      // zero copy, spans point into input
+    uint16_t spanCount = 0;
+    const char *pointer = chunkedBody;
+    decodedLength = 0;
+    resetHttpChunkedDecoder(&decoder);
+    HTTPParserStatus status;
+    do {
+        status = decodeHttpChunkedSpans(&decoder, pointer, strlen(pointer), spans, ARRAY_SIZE(spans), &spanCount);
+        for (uint16_t i = 0; i < spanCount; i++) {
+            assert_memory_equal(spans[i].length, pointer + spans[i].offset, decodedBody + decodedLength);
+            decodedLength += spans[i].length;
+        }
+        pointer += decoder.consumedLength;
+    } while (status == HTTP_PARSE_NEED_MORE_DATA);
+    assert_int(status, ==, HTTP_PARSE_OK);
+    assert_int(decodedLength, ==, strlen(decodedBody));
+    assert_string_equal(pointer, "GET /next");
+
+    strcpy(httpDataBuffer, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n2\r\nde\r\n0\r\n\r\n");
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_string_equal(parser->messageBody, "3\r\nabc\r\n2\r\nde\r\n0\r\n\r\n");   // caller buffer is not rewritten
+    assert_int(decodeHttpChunked(&parser->chunkedDecoder, parser->messageBody, strlen(parser->messageBody)), ==, HTTP_PARSE_OK);
+    assert_memory_equal(parser->chunkedDecoder.bodyLength, parser->messageBody, "abcde");
+    assert_int(parser->chunkedDecoder.bodyLength, ==, 5);
+    return MUNIT_OK;
+}
+
+static MunitResult decodeHttpChunkedFail(const MunitParameter params[], void *httpDataBuffer) {
+    const char *malformedBodies[] = {"\r\nabc\r\n0\r\n\r\n", "zz\r\n", "3\r\nabcX\r\n", "10000000000000000\r\n", "3\r\nabc\r\n0\r\n\rX", "3\x01\r\nabc"};
+    HTTPChunkedDecoder decoder;
+    for (uint32_t i = 0; i < ARRAY_SIZE(malformedBodies); i++) {
+        resetHttpChunkedDecoder(&decoder);
+        strcpy(httpDataBuffer, malformedBodies[i]);
+        assert_int(decodeHttpChunked(&decoder, httpDataBuffer, strlen(malformedBodies[i])), ==, HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY);
+        assert_int(decodeHttpChunked(&decoder, "0\r\n\r\n", 0), ==, HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY);    // sticky
+    }
+
+    resetHttpChunkedDecoder(&decoder);
+    strcpy(httpDataBuffer, "FFFFFFFFFFFFFFFF\r\nabc");     // chunk larger than 4 GiB is not wrapped
+    assert_int(decodeHttpChunked(&decoder, httpDataBuffer, strlen(httpDataBuffer)), ==, HTTP_PARSE_NEED_MORE_DATA);
+    assert_true(decoder.chunkRemaining == UINT64_MAX - 3);
+    assert_true(decoder.bodyLength == 3);
+    decoder.bodyLength = UINT64_MAX - 1;
+    assert_int(decodeHttpChunked(&decoder, httpDataBuffer, 2), ==, HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY);  // total length overflow
+
+    strcpy(httpDataBuffer, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n");   // no terminal chunk
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);    // body framing is checked only by decoder
+    assert_int(decodeHttpChunked(&parser->chunkedDecoder, parser->messageBody, strlen(parser->messageBody)), ==, HTTP_PARSE_NEED_MORE_DATA);
+    strcpy(httpDataBuffer, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n");
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(decodeHttpChunked(&parser->chunkedDecoder, parser->messageBody, strlen(parser->messageBody)), ==, HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY);
+    return MUNIT_OK;
+}
+
+static MunitResult pipelinedHttpMessagesOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *requests = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n"
+                           "POST /b HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello"
+                           "PUT /c HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n"
+                           "GET /d HTTP/1.";
+    const char *expectedPaths[] = {"/a", "/b", "/c"};
+    uint32_t expectedBodyLengths[] = {0, 5, 13};
+    HTTPMessageIterator iterator = getHttpMessageIterator(requests, strlen(requests), HTTP_REQUEST);
+    uint32_t messageCount = 0;
+    while (httpMessageHasNext(&iterator, parser)) {
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_http_uri_path(parser, iterator.message, expectedPaths[messageCount]);
+        assert_int(parser->messageBodyLength, ==, expectedBodyLengths[messageCount]);
+        messageCount++;
+    }
+    assert_int(messageCount, ==, 3);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_NEED_MORE_DATA);
+    assert_string_equal(requests + iterator.offset, "GET /d HTTP/1.");
+
+    const char *responses = "HTTP/1.1 204 No Content\r\n\r\n"
+                            "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok"
+                            "HTTP/1.1 200 OK\r\n\r\nuntil close";
+    iterator = getHttpMessageIterator(responses, strlen(responses), HTTP_RESPONSE);
+    assert_true(httpMessageHasNext(&iterator, parser));
+    assert_int(parser->statusCode, ==, HTTP_NO_CONTENT);
+    assert_int(parser->messageLength, ==, strlen("HTTP/1.1 204 No Content\r\n\r\n"));
+    assert_ptr_equal(iterator.message, responses);
+    assert_true(httpMessageHasNext(&iterator, parser));
+    assert_ptr_equal(iterator.message, responses + strlen("HTTP/1.1 204 No Content\r\n\r\n"));
+    assert_memory_equal(parser->messageBodyLength, parser->messageBody, "ok");
+    assert_true(httpMessageHasNext(&iterator, parser));
+    assert_memory_equal(parser->messageBodyLength, parser->messageBody, "until close");
+    assert_false(httpMessageHasNext(&iterator, parser));
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_EMPTY_DATA);
+
+    const char *malformed = "GET /a HTTP/1.1\r\n\r\nGET /b HTTP/7.1\r\n\r\n";
+    iterator = getHttpMessageIterator(malformed, strlen(malformed), HTTP_REQUEST);
+    assert_true(httpMessageHasNext(&iterator, parser));
+    assert_false(httpMessageHasNext(&iterator, parser));
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_NOT_SUPPORTED_HTTP_VERSION);
+
+    const char *request = "POST /b HTTP/1.1\r\nContent-Length: 5\r\n\r\nhelloGET";
+    parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+    assert_int(parser->messageLength, ==, strlen(request) - strlen("GET"));
+    return MUNIT_OK;
+}
+
+static MunitResult parseHttpBatchOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *buffers[] = {
+            "GET /a HTTP/1.1\r\nHost: x\r\n\r\n",
+            "POST /b HTTP/1.1\r\nContent-Length: 2\r\n\r\nok",
+            "GET /c HTTP/7.1\r\n\r\n",
+            "DELETE /d HTTP/1.0\r\n\r\n"
+    };
+    size_t lengths[ARRAY_SIZE(buffers)];
+    HTTPParser *parsers[ARRAY_SIZE(buffers)];
+    for (uint32_t i = 0; i < ARRAY_SIZE(buffers); i++) {
+        lengths[i] = strlen(buffers[i]);
+        parsers[i] = getHttpParserInstance();
+    }
+
+    assert_int(parseHttpBatch(buffers, lengths, parsers, ARRAY_SIZE(buffers), HTTP_REQUEST), ==, 3);
+    assert_int(parsers[0]->parserStatus, ==, HTTP_PARSE_OK);
+    assert_http_uri_path(parsers[0], buffers[0], "/a");
+    assert_int(parsers[1]->method, ==, HTTP_POST);
+    assert_memory_equal(2, parsers[1]->messageBody, "ok");
+    assert_int(parsers[2]->parserStatus, ==, HTTP_PARSE_ERROR_NOT_SUPPORTED_HTTP_VERSION);
+    assert_int(parsers[3]->method, ==, HTTP_DELETE);
+    assert_int(parseHttpBatch(buffers, lengths, parsers, 0, HTTP_REQUEST), ==, 0);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(buffers); i++) {
+        deleteHttpParser(parsers[i]);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult httpParserArenaOk(const MunitParameter params[], void *httpDataBuffer) {
+    static char arenaMemory[8192];
+    HTTPParserArena arena;
+    initHttpParserArena(&arena, arenaMemory, sizeof(arenaMemory));
+    HTTPParserAllocator allocator = getHttpParserArenaAllocator(&arena);
+
+    HTTPParser *arenaParser = getHttpParserInstanceWithAllocator(&allocator);
+    assert_true((char *) arenaParser >= arenaMemory && (char *) arenaParser < arenaMemory + 16);  // aligned start
+    const char *request = "GET / HTTP/1.1\r\nHost: a.com\r\nX-Request-Id: 42\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), arenaParser, HTTP_REQUEST);
+    assert_int(arenaParser->parserStatus, ==, HTTP_PARSE_OK);
+    parseHttpHeadersN(arenaParser, request, strlen(request));
+    assert_string_equal(arenaParser->knownHeaders[HTTP_HEADER_ID_HOST], "a.com");
+    assert_true(arenaParser->headersStorage.data > arenaMemory && arenaParser->headersStorage.data < arenaMemory + sizeof(arenaMemory));
+    assert_true((char *) arenaParser->unknownHeaders > arenaMemory && (char *) arenaParser->unknownHeaders < arenaMemory + sizeof(arenaMemory));
+    assert_null(arenaParser->headers);     // HashMap would malloc outside of arena
+    assert_string_equal(findHttpHeaderValue(arenaParser, "x-request-id"), "42");
+    parseHttpQueryParametersN(arenaParser, "/?a=1", strlen("/?a=1"));
+    assert_int(arenaParser->parserStatus, ==, HTTP_PARSE_ERROR_MAP_NOT_AVAILABLE);
+    assert_null(arenaParser->queryParameters);
+    size_t usedLength = arena.used;
+
+    parseHttpHeadersN(arenaParser, request, strlen(request));  // capacity is kept, nothing new allocated
+    assert_int(arena.used, ==, usedLength);
+    deleteHttpParser(arenaParser);  // no maps, arena memory stays until reset
+    assert_int(arena.used, ==, usedLength);
+    resetHttpParserArena(&arena);
+    assert_int(arena.used, ==, 0);
+    assert_ptr_equal(getHttpParserInstanceWithAllocator(&allocator), arenaParser);
+
+    initHttpParserArena(&arena, arenaMemory, sizeof(HTTPParser) - 1);     // too small
+    assert_null(getHttpParserInstanceWithAllocator(&allocator));
+    return MUNIT_OK;
+}
+
+static MunitResult httpParserPoolOk(const MunitParameter params[], void *httpDataBuffer) {
+    HTTPParserPool *pool = getHttpParserPoolInstance(2, NULL);
+    assert_not_null(pool);
+    HTTPParser *first = acquireHttpParser(pool);
+    HTTPParser *second = acquireHttpParser(pool);
+    assert_not_null(first);
+    assert_not_null(second);
+    assert_null(acquireHttpParser(pool));
+
+    const char *request = "GET /some/long/path HTTP/1.1\r\nHost: a.com\r\nTransfer-Encoding: gzip\r\nX-Id: 1\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), first, HTTP_REQUEST);
+    parseHttpHeadersN(first, request, strlen(request));
+    assert_http_uri_path(first, request, "/some/long/path");
+    char *headersStorage = first->headersStorage.data;
+    assert_true(releaseHttpParser(pool, first));
+    assert_int(first->requestTarget.pathLength, ==, 0);
+    assert_string_equal(first->transferEncodingTypes, "");
+    assert_null(first->knownHeaders[HTTP_HEADER_ID_HOST]);
+    assert_int(first->knownHeadersMask, ==, 0);
+    assert_int(first->unknownHeaderCount, ==, 0);
+
+    assert_ptr_equal(acquireHttpParser(pool), first);   // last released comes first
+    request = "GET /a HTTP/1.1\r\nHost: b.com\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), first, HTTP_REQUEST);
+    parseHttpHeadersN(first, request, strlen(request));
+    assert_http_uri_path(first, request, "/a");
+    assert_string_equal(first->transferEncodingTypes, "");
+    assert_string_equal(first->knownHeaders[HTTP_HEADER_ID_HOST], "b.com");
+    assert_ptr_equal(first->headersStorage.data, headersStorage);   // capacity kept
+
+    assert_true(releaseHttpParser(pool, first));
+    assert_false(releaseHttpParser(pool, first));   // double release
+    assert_int(pool->freeCount, ==, 1);
+    assert_false(releaseHttpParser(pool, parser));  // not from this pool
+    HTTPParserPool *otherPool = getHttpParserPoolInstance(1, NULL);
+    HTTPParser *foreign = acquireHttpParser(otherPool);
+    assert_false(releaseHttpParser(pool, foreign));
+    assert_true(releaseHttpParser(otherPool, foreign));
+    deleteHttpParserPool(otherPool);
+
+    const char nulRequest[] = "POST / HTTP/1.1\r\nTransfer-Encoding: a\0bbbbbbbbbbbbbbbbbbbbbbbbbbbb\r\n\r\n";
+    second->validationChecks = HTTP_VALIDATION_TRUSTED;     // NUL reaches stored value only without value check
+    parseHttpBufferN(nulRequest, sizeof(nulRequest) - 1, second, HTTP_REQUEST);
+    assert_true(releaseHttpParser(pool, second));
+    assert_ptr_equal(acquireHttpParser(pool), second);
+    request = "POST / HTTP/1.1\r\nTransfer-Encoding: gzip, chunked\r\n\r\n0\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), second, HTTP_REQUEST);
+    assert_int(second->parserStatus, ==, HTTP_PARSE_OK);
+    assert_memory_equal(HTTP_TRANSFER_ENCODING_TYPES_LENGTH, second->transferEncodingTypes, "gzip, chunked\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0");
+    second->validationChecks = HTTP_VALIDATION_PROFILE;
+
+    assert_true(releaseHttpParser(pool, second));
+    assert_false(releaseHttpParser(pool, second));
+    assert_int(pool->freeCount, ==, 2);
+    deleteHttpParserPool(pool);
+    return MUNIT_OK;
+}
+
+static MunitResult httpFindHeaderOk(const MunitParameter params[], void *httpDataBuffer) {
+    strcpy(httpDataBuffer, testRequest);
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->headersEndOffset, ==, strstr(testRequest, "\n\n") + 1 - testRequest);   // bounds from body lookup
+
+    HTTPHeaderSpan host = httpFindHeader(parser, httpDataBuffer, "Host");
+    assert_int(host.nameLength, ==, 4);
+    assert_memory_equal(host.valueLength, (char *) httpDataBuffer + host.valueOffset, "www.example.com");
+    assert_int(host.valueLength, ==, strlen("www.example.com"));
+    assert_int(parser->headersStartOffset, ==, strchr(testRequest, '\n') + 1 - testRequest);   // request line cached
+
+    HTTPHeaderSpan connection = httpFindHeader(parser, httpDataBuffer, "Connection");
+    assert_memory_equal(connection.valueLength, (char *) httpDataBuffer + connection.valueOffset, "Keep-Alive");
+    assert_int(httpFindHeader(parser, httpDataBuffer, "Authorization").nameLength, ==, 0);
+    assert_int(httpFindHeader(parser, httpDataBuffer, "Hos").nameLength, ==, 0);
+
+    strcpy(httpDataBuffer, "HTTP/1.1 204 No Content\r\nServer: test \r\nX-Empty:\r\n\r\n");    // body is skipped
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_RESPONSE);
+    assert_int(parser->headersEndOffset, ==, strlen(httpDataBuffer) - 2);    // Content-Length miss scanned whole block
+    HTTPHeaderSpan server = httpFindHeader(parser, httpDataBuffer, "Server");
+    assert_memory_equal(server.valueLength, (char *) httpDataBuffer + server.valueOffset, "test");
+    assert_int(server.valueLength, ==, 4);
+    assert_int(httpFindHeader(parser, httpDataBuffer, "X-Empty").valueLength, ==, 0);
+    assert_int(httpFindHeader(parser, httpDataBuffer, "Date").nameLength, ==, 0);
+    assert_int(parser->headersEndOffset, ==, strlen(httpDataBuffer) - 2);
+
+    char *request = httpDataBuffer;     // more headers than index capacity, found by scan
+    strcpy(request, "GET / HTTP/1.1\r\n");
+    for (uint32_t i = 0; i < HTTP_HEADER_INDEX_CAPACITY + 4; i++) {
+        sprintf(request + strlen(request), "X-Header-%u: %u\r\n", i, i);
+    }
+    strcat(request, "\r\n");
+    parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    char name[32];
+    sprintf(name, "X-Header-%u", HTTP_HEADER_INDEX_CAPACITY + 2);
+    HTTPHeaderSpan lastHeader = httpFindHeader(parser, request, name);
+    assert_int(lastHeader.nameLength, ==, strlen(name));
+    assert_int(atoi(request + lastHeader.valueOffset), ==, HTTP_HEADER_INDEX_CAPACITY + 2);
+    return MUNIT_OK;
+}
+
+static MunitResult httpFindHeaderNLengthBoundOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *head = "GET / HTTP/1.1\r\nAccept: */*\r\nHost: example.com";
+    size_t length = strlen(head);
+    char *truncated = malloc(length);   // no NUL terminator, any read past length is caught by sanitizer
+    memcpy(truncated, head, length);
+
+    parseHttpBufferN(truncated, length, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, !=, HTTP_PARSE_OK);
+    HTTPHeaderSpan host = httpFindHeaderN(parser, truncated, length, "Host");
+    assert_memory_equal(host.valueLength, truncated + host.valueOffset, "example.com");
+    assert_int(httpFindHeaderN(parser, truncated, length - 4, "Host").nameLength, ==, 0);  // indexed span beyond length
+
+    resetHttpParser(parser, HTTP_REQUEST);     // no index, lines are scanned
+    host = httpFindHeaderN(parser, truncated, length, "Host");
+    assert_int(host.nameLength, ==, 4);
+    assert_memory_equal(host.valueLength, truncated + host.valueOffset, "example.com");
+    assert_int(httpFindHeaderN(parser, truncated, length, "Date").nameLength, ==, 0);
+    assert_int(httpFindHeaderN(parser, truncated, length - strlen(": example.com"), "Host").nameLength, ==, 0);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);     // colon is not reached yet, not malformed
+
+    length = strlen("GET / HTTP/1.1");      // request line is cut, no header block bounds known
+    parseHttpBufferN(truncated, length, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, !=, HTTP_PARSE_OK);
+    assert_int(httpFindHeader(parser, truncated, "Host").nameLength, ==, 0);
+    assert_int(httpFindHeaderN(parser, truncated, length, "Host").nameLength, ==, 0);
+    free(truncated);
+    return MUNIT_OK;
+}
+
+
+static MunitResult headerNameCaseInsensitiveOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *request = "POST /upload HTTP/1.1\r\nhOST: a.com\r\ncontent-length: 5\r\naCCEPT-eNCODING: gzip\r\nx-long-header-name: 1\r\n\r\nhello";
+    strcpy(httpDataBuffer, request);
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->contentLength, ==, 5);
+
+    parseHttpMessage(request, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->contentLength, ==, 5);
+    assert_int(findHttpHeaderSpan(parser, request, "Content-Length")->valueLength, ==, 1);
+    assert_int(httpFindHeader(parser, request, "X-LONG-HEADER-NAME").valueLength, ==, 1);
+
+    parseHttpHeadersN(parser, request, strlen(request));
+    assert_string_equal(hashMapGet(parser->headers, "hOST"), "a.com");    // map keeps spelling from the message
+    assert_string_equal(hashMapGet(parser->headers, "content-length"), "5");
+    assert_null(hashMapGet(parser->headers, "Content-Length"));
+    assert_string_equal(hashMapGet(parser->headers, "x-long-header-name"), "1");
+    assert_string_equal(findHttpHeaderValue(parser, "Host"), "a.com");
+    assert_string_equal(findHttpHeaderValue(parser, "CONTENT-length"), "5");
+    assert_string_equal(findHttpHeaderValue(parser, "X-Long-Header-Name"), "1");
+    assert_null(findHttpHeaderValue(parser, "X-Long-Header"));
+    assert_string_equal(parser->knownHeaders[HTTP_HEADER_ID_ACCEPT_ENCODING], "gzip");
+
+    assert_int(getHttpHeaderId("content-type", 12), ==, HTTP_HEADER_ID_CONTENT_TYPE);
+    assert_int(getHttpHeaderId("WWW-AUTHENTICATE", 16), ==, HTTP_HEADER_ID_WWW_AUTHENTICATE);
+    assert_int(getHttpHeaderId("Content-Typ[", 12), ==, HTTP_HEADER_ID_UNKNOWN);   // '[' is not case pair of '{' or 'e'
+
+    const char *chunked = "GET / HTTP/1.1\r\ntransfer-encoding: chunked\r\nContent-length: 3\r\n\r\n";
+    strcpy(httpDataBuffer, chunked);
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_UNEXPECTED_CONTENT_LENGTH);
+    return MUNIT_OK;
+}
+
+static MunitResult requestTargetSpansOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *request = "GET /files/report.pdf?X-Signature=abc%2F123&expires=1700000000#page=2 HTTP/1.1\r\nHost: a.com\r\n\r\n";
+    for (uint32_t i = 0; i < 2; i++) {
+        strcpy(httpDataBuffer, request);
+        i == 0 ? parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST) : parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        HTTPRequestTarget *target = &parser->requestTarget;
+        assert_http_uri_path(parser, request, "/files/report.pdf");
+        assert_memory_equal(target->queryLength, request + target->queryOffset, "X-Signature=abc%2F123&expires=1700000000");
+        assert_int(target->queryLength, ==, strlen("X-Signature=abc%2F123&expires=1700000000"));
+        assert_memory_equal(target->fragmentLength, request + target->fragmentOffset, "page=2");
+        assert_int(target->fragmentLength, ==, 6);
+
+        char uriPath[HTTP_REQUEST_URI_PATH_LENGTH];     // former uriPath field
+        assert_true(getHttpUriPath(parser, request, uriPath, sizeof(uriPath)));
+        assert_string_equal(uriPath, "/files/report.pdf");
+        assert_false(getHttpUriPath(parser, request, uriPath, strlen("/files/report.pdf")));
+        assert_string_equal(uriPath, "");
+    }
+
+    char *longRequest = httpDataBuffer;     // signed URL far above former 80 bytes limit
+    strcpy(longRequest, "GET /download?signature=");
+    memset(longRequest + strlen(longRequest), 's', 1000);
+    strcpy(longRequest + strlen("GET /download?signature=") + 1000, " HTTP/1.1\r\n\r\n");
+    parseHttpBufferN(longRequest, strlen(longRequest), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_http_uri_path(parser, longRequest, "/download");
+    assert_int(parser->requestTarget.queryLength, ==, strlen("signature=") + 1000);
+    parseHttpBuffer(longRequest, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->requestTarget.queryLength, ==, strlen("signature=") + 1000);
+
+    parser->maxRequestTargetLength = 100;
+    parseHttpBuffer(longRequest, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_URI_PATH_TOO_LONG);
+    parseHttpBufferN(longRequest, strlen(longRequest), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_URI_PATH_TOO_LONG);
+
+    strcpy(httpDataBuffer, "GET /a?b HTTP/1.1\r\n\r\n");
+    parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->requestTarget.queryLength, ==, 1);
+    assert_int(parser->requestTarget.fragmentLength, ==, 0);   // cleared from previous parse
+    return MUNIT_OK;
+}
+
+static MunitResult httpQueryParameterIteratorOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *request = "GET /search?q=caf%C3%A9+au+lait&&debug&=skipped&page=2#top HTTP/1.1\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+
+    const char *expectedKeys[] = {"q", "debug", "page"};
+    const char *expectedValues[] = {"caf%C3%A9+au+lait", "", "2"};
+    uint32_t count = 0;
+    HTTPQueryParameterIterator iterator = getHttpQueryParameterIterator(parser, request);
+    while (httpQueryParameterHasNext(&iterator)) {
+        assert_int(iterator.keyLength, ==, strlen(expectedKeys[count]));
+        assert_memory_equal(iterator.keyLength, iterator.key, expectedKeys[count]);
+        assert_int(iterator.valueLength, ==, strlen(expectedValues[count]));
+        assert_memory_equal(iterator.valueLength, iterator.value, expectedValues[count]);
+        count++;
+    }
+    assert_int(count, ==, 3);
+
+    char value[32];
+    size_t valueLength;
+    assert_true(decodeHttpQueryComponent("caf%C3%A9+au+lait", 17, value, sizeof(value), &valueLength));
+    assert_int(valueLength, ==, strlen("caf\xc3\xa9 au lait"));
+    assert_string_equal(value, "caf\xc3\xa9 au lait");
+    assert_true(decodeHttpQueryComponent("%2f%2F", 6, value, 2, &valueLength));   // exact fit, no NUL
+    assert_memory_equal(2, value, "//");
+    assert_false(decodeHttpQueryComponent("abc", 3, value, 2, &valueLength));
+    assert_false(decodeHttpQueryComponent("a%2", 3, value, sizeof(value), &valueLength));
+    assert_false(decodeHttpQueryComponent("a%zz", 4, value, sizeof(value), &valueLength));
+
+    strcpy(httpDataBuffer, "name=J%C3%B6rg+M%C3%BCller");     // in place, e.g. form body
+    iterator = getHttpQueryStringIterator(httpDataBuffer, strlen(httpDataBuffer));
+    assert_true(httpQueryParameterHasNext(&iterator));
+    assert_true(decodeHttpQueryComponent(iterator.value, iterator.valueLength, (char *) iterator.value, iterator.valueLength, &valueLength));
+    assert_memory_equal(valueLength, iterator.value, "J\xc3\xb6rg M\xc3\xbcller");
+    assert_false(httpQueryParameterHasNext(&iterator));
+
+    request = "GET /no-query HTTP/1.1\r\n\r\n";
+    parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+    iterator = getHttpQueryParameterIterator(parser, request);
+    assert_false(httpQueryParameterHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+static MunitResult normalizeHttpPathOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *paths[][2] = {
+            {"/", "/"},
+            {"/api/v1/users", "/api/v1/users"},
+            {"//api///v1//", "/api/v1/"},
+            {"/a/./b/.", "/a/b/"},
+            {"/a/b/../c", "/a/c"},
+            {"/a/b/..", "/a/"},
+            {"/../../etc/passwd", "/etc/passwd"},
+            {"/a/%2e%2E/b", "/b"},
+            {"/caf%C3%A9/%7euser", "/caf\xc3\xa9/~user"},
+            {"/a%2fb/%2F..", "/a%2Fb/%2F.."},
+            {"/..a/.b./...", "/..a/.b./..."},
+            {"/very/long/segment-that-is-longer-than-one-vector-register/../x", "/very/long/x"},
+            {"relative/./path", "/relative/path"},
+    };
+    char path[128];
+    size_t pathLength;
+    for (uint32_t i = 0; i < ARRAY_SIZE(paths); i++) {
+        assert_true(normalizeHttpPath(paths[i][0], strlen(paths[i][0]), path, sizeof(path), &pathLength));
+        assert_string_equal(path, paths[i][1]);
+        assert_int(pathLength, ==, strlen(paths[i][1]));
+    }
+    assert_false(normalizeHttpPath("/a%zz", 5, path, sizeof(path), &pathLength));
+    assert_false(normalizeHttpPath("/a%2", 4, path, sizeof(path), &pathLength));
+    assert_false(normalizeHttpPath("/a%00b", 6, path, sizeof(path), &pathLength));
+    assert_false(normalizeHttpPath("/abcdef", 7, path, 4, &pathLength));
+    assert_true(normalizeHttpPath("/abc", 4, path, 4, &pathLength));    // exact fit, no NUL
+    assert_memory_equal(4, path, "/abc");
+
+    const char *request = "GET /static/../img//logo%2Epng?v=1 HTTP/1.1\r\n\r\n";
+    parseHttpMessage(request, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_true(normalizeHttpRequestPath(parser, request, path, sizeof(path), &pathLength));
+    assert_string_equal(path, "/img/logo.png");
+    return MUNIT_OK;
+}
+
+static MunitResult contentLength64BitOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *values[] = {"0", "7", "12345678", "123456789", "1234567890123456", "18446744073709551615", "00000000000000000000000042", "5  "};
+    const uint64_t expected[] = {0, 7, 12345678, 123456789, 1234567890123456ULL, UINT64_MAX, 42, 5};
+    for (uint32_t i = 0; i < ARRAY_SIZE(values); i++) {
+        sprintf(httpDataBuffer, "HTTP/1.1 200 OK\r\ncontent-length: %s\r\n\r\n", values[i]);
+        char *response = httpDataBuffer;
+        parseHttpMessage(response, parser, HTTP_RESPONSE);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_uint64(parser->contentLength, ==, expected[i]);
+
+        resetHttpParser(parser, HTTP_RESPONSE);
+        for (size_t position = 0; position < strlen(response); position++) {
+            httpParserFeed(parser, response + position, 1);
+        }
+        assert_uint64(parser->contentLength, ==, expected[i]);
+
+        parseHttpBuffer(response, parser, HTTP_RESPONSE);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_uint64(parser->contentLength, ==, expected[i]);
+    }
+
+    const char *invalidHeaders[] = {
+            "Content-Length: 18446744073709551616\r\n",
+            "Content-Length: 99999999999999999999\r\n",
+            "Content-Length: 12a\r\n",
+            "Content-Length: 1 2\r\n",
+            "Content-Length: -1\r\n",
+            "Content-Length: \r\n",
+            "Content-Length: 5\r\nContent-Length: 5\r\n",
+            "Content-Length: 5\r\ncontent-length: 6\r\n",
+    };
+    for (uint32_t i = 0; i < ARRAY_SIZE(invalidHeaders); i++) {
+        sprintf(httpDataBuffer, "POST / HTTP/1.1\r\n%s\r\n", invalidHeaders[i]);
+        parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH);
+        assert_uint64(parser->contentLength, ==, 0);
+        resetHttpParser(parser, HTTP_REQUEST);
+        for (size_t position = 0; position < strlen(httpDataBuffer); position++) {
+            httpParserFeed(parser, (char *) httpDataBuffer + position, 1);
+        }
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH);
+        assert_uint64(parser->contentLength, ==, 0);
+        parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH);
+        assert_uint64(parser->contentLength, ==, 0);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult reasonPhraseSkipOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *responses[] = {"HTTP/1.1 200 Whatever\r\n\r\n", "HTTP/1.1 404 \r\n\r\n", "HTTP/1.0 503\r\n\r\n", "HTTP/1.1 200 OK\r\n\r\n"};
+    const HTTPStatus expected[] = {HTTP_OK, HTTP_NOT_FOUND, HTTP_SERVICE_UNAVAILABLE, HTTP_OK};
+    const HTTPParserStatus strictStatuses[] = {HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE, HTTP_PARSE_ERROR_STATUS_CODE_MESSAGE_NOT_FOUND, HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE, HTTP_PARSE_OK};
+    for (uint32_t i = 0; i < ARRAY_SIZE(responses); i++) {
+        strcpy(httpDataBuffer, responses[i]);
+        char *response = httpDataBuffer;
+        parser->validationChecks = HTTP_VALIDATION_STRICT;
+        parseHttpMessage(response, parser, HTTP_RESPONSE);
+        assert_int(parser->parserStatus, ==, strictStatuses[i]);
+
+        parser->validationChecks &= ~HTTP_CHECK_REASON_PHRASE;
+        parseHttpMessage(response, parser, HTTP_RESPONSE);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_int(parser->statusCode, ==, expected[i]);
+        assert_uint32(parser->headersStartOffset, ==, strlen(response) - 2);
+
+        resetHttpParser(parser, HTTP_RESPONSE);
+        for (size_t position = 0; position < strlen(response); position++) {
+            httpParserFeed(parser, response + position, 1);
+        }
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_int(parser->statusCode, ==, expected[i]);
+
+        parseHttpBuffer(response, parser, HTTP_RESPONSE);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+        assert_int(parser->statusCode, ==, expected[i]);
+    }
+
+    strcpy(httpDataBuffer, "HTTP/1.1 200x\r\n\r\n");
+    parseHttpMessage(httpDataBuffer, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_HTTP_STATUS_CODE);
+
+    const char *ctlResponses[] = {"HTTP/1.1 200 OK\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\r\n\r\n", "HTTP/1.1 200 O\001K\r\n\r\n", "HTTP/1.1 404 \0Not Found\r\n\r\n"};
+    const size_t ctlResponseLengths[] = {39, 20, 27};
+    parser->validationChecks = HTTP_VALIDATION_STRICT;
+    for (uint32_t i = 0; i < ARRAY_SIZE(ctlResponses); i++) {   // NUL never matches end of expected phrase
+        parseHttpBufferN(ctlResponses[i], ctlResponseLengths[i], parser, HTTP_RESPONSE);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE);
+    }
+
+    resetHttpParser(parser, HTTP_RESPONSE);     // fast path is not taken inside constant split across chunks
+    assert_int(httpParserFeed(parser, "H", 1), ==, HTTP_PARSE_NEED_MORE_DATA);
+    assert_int(httpParserFeed(parser, "HTTP/1.1 200 OK\r\n\r\n", 19), ==, HTTP_PARSE_ERROR_NOT_FOUND_HTTP_CONSTANT);
+    resetHttpParser(parser, HTTP_RESPONSE);
+    assert_int(httpParserFeed(parser, "HT", 2), ==, HTTP_PARSE_NEED_MORE_DATA);
+    assert_int(httpParserFeed(parser, "TP/1.1 200 OK\r\n\r\n", 19), ==, HTTP_PARSE_OK);
+    assert_int(parser->statusCode, ==, HTTP_OK);
+    parser->validationChecks = HTTP_VALIDATION_STRICT;
+    return MUNIT_OK;
+}
+
+static MunitResult validationProfilesOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *request = "GET /a\001b HTTP/1.1\r\nX-Ctl: a\001b\r\nX(y): 1\r\n\r\n";
+    const uint8_t profiles[] = {HTTP_VALIDATION_STRICT, HTTP_VALIDATION_LENIENT, HTTP_VALIDATION_TRUSTED};
+    const HTTPParserStatus targetStatuses[] = {HTTP_PARSE_ERROR_INVALID_URI_PATH, HTTP_PARSE_ERROR_INVALID_URI_PATH, HTTP_PARSE_OK};
+    const uint32_t headerCounts[] = {0, 1, 2};
+    for (uint32_t i = 0; i < ARRAY_SIZE(profiles); i++) {
+        parser->validationChecks = profiles[i];
+        parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, targetStatuses[i]);
+        strcpy(httpDataBuffer, request);
+        parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, targetStatuses[i]);
+
+        parseHttpHeadersN(parser, request, strlen(request));
+        assert_int(getHashMapSize(parser->headers), ==, headerCounts[i]);
+    }
+    assert_string_equal(hashMapGet(parser->headers, "X(y)"), "1");
+    assert_string_equal(hashMapGet(parser->headers, "X-Ctl"), "a\001b");
+    parser->validationChecks = HTTP_VALIDATION_PROFILE;
+    return MUNIT_OK;
+}
+
+static void assertHttpHeaderLimitStatus(const char *request, HTTPParserStatus expected) {
+    parseHttpMessage(request, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, expected);
+    resetHttpParser(parser, HTTP_REQUEST);
+    for (size_t position = 0; position < strlen(request) && parser->parserStatus != expected; position++) {
+        httpParserFeed(parser, request + position, 1);
+    }
+    assert_int(parser->parserStatus, ==, expected);
+
+    parseHttpHeadersN(parser, request, strlen(request));
+    assert_int(parser->parserStatus, ==, expected);
+}
+
+static MunitResult headerLimitsOk(const MunitParameter params[], void *httpDataBuffer) {
+    parser->maxHeaderCount = 2;
+    parser->maxHeaderLineLength = 16;
+    parser->maxHeadersLength = 64;
+    assertHttpHeaderLimitStatus("GET / HTTP/1.1\r\nHost: a\r\nX-A: 0123456789a\r\nno colon line\r\n\r\n", HTTP_PARSE_OK);
+    assertHttpHeaderLimitStatus("GET / HTTP/1.1\r\nHost: a\r\nX-A: 1\r\nX-B: 2\r\n\r\n", HTTP_PARSE_ERROR_TOO_MANY_HEADERS);
+    assertHttpHeaderLimitStatus("GET / HTTP/1.1\r\nHost: a\r\nX-A: 0123456789ab\r\n\r\n", HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG);
+    assertHttpHeaderLimitStatus("GET / HTTP/1.1\r\nno colon line, but long\r\n\r\n", HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG);
+    assertHttpHeaderLimitStatus("GET / HTTP/1.1\r\na\r\nb\r\nc\r\nd\r\ne\r\nf\r\ng\r\nh\r\ni\r\nj\r\nk\r\nl\r\nm\r\nn\r\no\r\np\r\nq\r\nr\r\ns\r\nt\r\nu\r\nv\r\n\r\n",
+                                HTTP_PARSE_ERROR_HEADERS_TOO_LONG);
+
+    char *request = httpDataBuffer;     // unterminated line is rejected without scanning to buffer end
+    strcpy(request, "GET / HTTP/1.1\r\nX-A: ");
+    memset(request + strlen(request), 'a', 2000);
+    request[2000 + 21] = '\0';
+    parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG);
+    assert_uint32(parser->parsedLength, ==, 16 + 16 + 1);
+
+    strcpy(request, "GET / HTTP/1.1\r\nHost: a\r\nX-A: 1\r\nX-B: 2\r\n\r\n");
+    parseHttpHeaders(parser, request);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_TOO_MANY_HEADERS);
+
+    uint32_t valueLength = UINT16_MAX + 10;     // raised limit above 16 bits is not truncated in spans
+    parser->maxHeaderLineLength = valueLength + 16;
+    parser->maxHeadersLength = valueLength + 64;
+    char *longRequest = malloc(valueLength + 64);
+    strcpy(longRequest, "GET / HTTP/1.1\r\nX-Long: ");
+    size_t headLength = strlen(longRequest);
+    memset(longRequest + headLength, 'a', valueLength);
+    strcpy(longRequest + headLength + valueLength, "\r\n\r\n");
+    parseHttpMessage(longRequest, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    HTTPHeaderIterator iterator = getHttpHeaderIterator(parser, longRequest);
+    assert_true(httpHeaderHasNext(&iterator));
+    assert_uint32(iterator.valueLength, ==, valueLength);
+    parser->headerCount = 0;    // lookup by line scan
+    assert_uint32(httpFindHeader(parser, longRequest, "X-Long").valueLength, ==, valueLength);
+    free(longRequest);
+    return MUNIT_OK;
+}
+
+static char *joinHttpVectors(const HTTPSerializer *serializer, char *buffer) {
+    char *pointer = buffer;
+    for (uint16_t i = 0; i < serializer->count; i++) {
+        memcpy(pointer, serializer->vectors[i].iov_base, serializer->vectors[i].iov_len);
+        pointer += serializer->vectors[i].iov_len;
+    }
+    *pointer = '\0';
+    assert_size(pointer - buffer, ==, serializer->length);
+    return buffer;
+}
+
+static MunitResult httpSerializerOk(const MunitParameter params[], void *httpDataBuffer) {
+    HTTPIoVector vectors[24];
+    HTTPSerializer serializer;
+    initHttpSerializer(&serializer, vectors, ARRAY_SIZE(vectors));
+
+    const char *json = "{\"id\":42}";
+    const HTTPOutputHeader headers[] = {{HTTP_HEADER_ID_CONTENT_TYPE, NULL, "application/json"}, {HTTP_HEADER_ID_UNKNOWN, "X-Trace", "abc"}};
+    const HTTPBodySegment body[] = {{json, 5}, {"", 0}, {json + 5, strlen(json) - 5}};
+    assert_int(serializeHttpResponse(&serializer, HTTP_OK, headers, ARRAY_SIZE(headers), body, ARRAY_SIZE(body)), ==, 15);
+    assert_string_equal(joinHttpVectors(&serializer, httpDataBuffer), "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nX-Trace: abc\r\n"
+                                                                      "Content-Length: 9\r\n\r\n{\"id\":42}");
+    assert_ptr_equal(vectors[13].iov_base, json);   // body is not copied
+    parseHttpMessage(httpDataBuffer, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_uint64(parser->contentLength, ==, 9);
+    assert_string_equal(parser->messageBody, json);
+
+    const HTTPOutputHeader chunked[] = {{HTTP_HEADER_ID_UNKNOWN, "transfer-encoding", "chunked"}};
+    const char *chunkedBody = "3\r\nabc\r\n0\r\n\r\n";
+    const HTTPBodySegment chunk = {chunkedBody, strlen(chunkedBody)};
+    assert_int(serializeHttpRequest(&serializer, HTTP_POST, "/upload?id=1", chunked, 1, &chunk, 1), ==, 9);
+    assert_string_equal(joinHttpVectors(&serializer, httpDataBuffer), "POST /upload?id=1 HTTP/1.1\r\ntransfer-encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n");
+    parseHttpMessage(httpDataBuffer, parser, HTTP_REQUEST);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_int(parser->method, ==, HTTP_POST);
+
+    assert_int(serializeHttpResponse(&serializer, (HTTPStatus) 202, NULL, 0, NULL, 0), >, 0);
+    sprintf(httpDataBuffer + 1000, "HTTP/1.1 202 %s\r\n\r\n", getHttpStatusCodeMeaning((HTTPStatus) 202));
+    assert_string_equal(joinHttpVectors(&serializer, httpDataBuffer), httpDataBuffer + 1000);
+    assert_int(serializeHttpRequest(&serializer, HTTP_GET, "/", NULL, 0, NULL, 0), ==, 4);
+    assert_string_equal(joinHttpVectors(&serializer, httpDataBuffer), "GET / HTTP/1.1\r\n\r\n");
+
+    assert_int(serializeHttpResponse(&serializer, HTTP_NO_STATUS, NULL, 0, NULL, 0), ==, 0);
+    assert_int(serializeHttpRequest(&serializer, HTTP_NO_METHOD, "/", NULL, 0, NULL, 0), ==, 0);
+
+    const HTTPOutputHeader injectedHeaders[][1] = {     // CR, LF, NUL and other CTL can't split a header line
+            {{HTTP_HEADER_ID_UNKNOWN, "X-Id", "1\r\nSet-Cookie: a=b"}},
+            {{HTTP_HEADER_ID_LOCATION, NULL, "/a\nb"}},
+            {{HTTP_HEADER_ID_UNKNOWN, "X-Id\r\nSet-Cookie", "a=b"}},
+            {{HTTP_HEADER_ID_UNKNOWN, "X Id", "1"}},
+            {{HTTP_HEADER_ID_UNKNOWN, "", "1"}},
+            {{HTTP_HEADER_ID_UNKNOWN, "X-Id", "\r\n"}}
+    };
+    for (uint32_t i = 0; i < ARRAY_SIZE(injectedHeaders); i++) {
+        assert_int(serializeHttpResponse(&serializer, HTTP_OK, injectedHeaders[i], 1, NULL, 0), ==, 0);
+        assert_int(serializeHttpRequest(&serializer, HTTP_GET, "/", injectedHeaders[i], 1, NULL, 0), ==, 0);
+    }
+    assert_int(serializeHttpRequest(&serializer, HTTP_GET, "/a HTTP/1.1\r\nHost: b\r\n\r\nGET /b", NULL, 0, NULL, 0), ==, 0);
+    assert_int(serializeHttpRequest(&serializer, HTTP_GET, "/a\tb", NULL, 0, NULL, 0), ==, 0);
+    assert_int(serializeHttpRequest(&serializer, HTTP_GET, "", NULL, 0, NULL, 0), ==, 0);
+    assert_int(serializeHttpResponse(&serializer, HTTP_OK, (HTTPOutputHeader[]) {{HTTP_HEADER_ID_UNKNOWN, "X-Empty", ""}}, 1, NULL, 0), >, 0);
+
+    initHttpSerializer(&serializer, vectors, 14);
+    assert_int(serializeHttpResponse(&serializer, HTTP_OK, headers, ARRAY_SIZE(headers), body, ARRAY_SIZE(body)), ==, 0);
+    assert_size(serializer.length, ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult headerSpaceBeforeColonFail(const MunitParameter params[], void *httpDataBuffer) {
+    const char *requests[] = {
+            "POST / HTTP/1.1\r\nContent-Length : 5\r\n\r\nhello",
+            "POST / HTTP/1.1\r\nHost: a\r\nContent-Length\t: 5\r\n\r\nhello",
+            "POST / HTTP/1.1\r\nContent-Length: 5\r\nContent-Length : 7\r\n\r\nhello",
+            "GET / HTTP/1.1\r\nX-Custom  : a\r\n\r\n"
+    };
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(requests); i++) {    // single-pass engine, whole and byte by byte
+        parseHttpBufferN(requests[i], strlen(requests[i]), parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_HEADER);
+
+        resetHttpParser(parser, HTTP_REQUEST);
+        HTTPParserStatus status = HTTP_PARSE_NEED_MORE_DATA;
+        for (size_t j = 0; j < strlen(requests[i]) && status == HTTP_PARSE_NEED_MORE_DATA; j++) {
+            status = httpParserFeed(parser, requests[i] + j, 1);
+        }
+        assert_int(status, ==, HTTP_PARSE_ERROR_INVALID_HEADER);
+
+        parseHttpHeadersN(parser, requests[i], strlen(requests[i]));
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_HEADER);
+    }
+
+    for (uint32_t i = 0; i < 3; i++) {    // Content-Length lookup of in place parser
+        strcpy(httpDataBuffer, requests[i]);
+        parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_HEADER);
+        assert_int(parser->contentLength, ==, 0);
+    }
+
+    strcpy(httpDataBuffer, "HTTP/1.1 200 OK\r\nServer : test\r\n\r\n");
+    parseHttpBuffer(httpDataBuffer, parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);    // not looked up yet
+    assert_int(httpFindHeader(parser, httpDataBuffer, "Server").nameLength, ==, 0);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_HEADER);
+    return MUNIT_OK;
+}
+
+static MunitResult transferCodingsOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *codings[] = {
+            "Transfer-Encoding: CHUNKED",
+            "Transfer-Encoding: gzip ,\t Chunked ",
+            "Transfer-Encoding: gzip\r\nTransfer-Encoding: chunked",
+            "Transfer-Encoding: chunked\r\nTransfer-Encoding: gzip",     // last header has final coding
+            "Transfer-Encoding: chunked, gzip",
+            "Transfer-Encoding: chunked, chunked",
+            "Transfer-Encoding: gzip",
+            "Transfer-Encoding: xchunked",
+            "Transfer-Encoding: chunked\r\nContent-Length: 0",
+            "Transfer-Encoding: gzip, deflate, br, compress, identity, chunked"
+    };
+    const HTTPParserStatus expected[] = {
+            HTTP_PARSE_OK, HTTP_PARSE_OK, HTTP_PARSE_OK,
+            HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING, HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING, HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING,
+            HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING, HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING,
+            HTTP_PARSE_ERROR_UNEXPECTED_CONTENT_LENGTH, HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING
+    };
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(codings); i++) {
+        char request[256];
+        sprintf(request, "POST / HTTP/1.1\r\n%s\r\n\r\n3\r\nabc\r\n0\r\n\r\n", codings[i]);
+        parseHttpBufferN(request, strlen(request), parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, expected[i]);
+        assert_true(parser->parserStatus != HTTP_PARSE_OK || (isHttpBodyChunked(parser) && parser->messageBodyLength == strlen("3\r\nabc\r\n0\r\n\r\n")));
+
+        resetHttpParser(parser, HTTP_REQUEST);
+        HTTPParserStatus status = HTTP_PARSE_NEED_MORE_DATA;
+        for (size_t position = 0; position < strlen(request) && status == HTTP_PARSE_NEED_MORE_DATA; position++) {
+            status = httpParserFeed(parser, request + position, 1);
+        }
+        assert_int(status, ==, expected[i]);
+
+        strcpy(httpDataBuffer, request);
+        parseHttpBuffer(httpDataBuffer, parser, HTTP_REQUEST);
+        assert_int(parser->parserStatus, ==, expected[i]);
+    }
+    const char *repeated = "GET / HTTP/1.1\r\nTransfer-Encoding: gzip\r\nTransfer-Encoding: chunked\r\n\r\n";
+    parseHttpBufferN(repeated, strlen(repeated), parser, HTTP_REQUEST);
+    assert_string_equal(parser->transferEncodingTypes, "gzip, chunked");
+
+    const char *response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: gzip\r\n\r\nuntil close";   // response body without chunked ends with close
+    parseHttpBufferN(response, strlen(response), parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_OK);
+    assert_false(isHttpBodyChunked(parser));
+    assert_int(parser->messageBodyLength, ==, strlen("until close"));
+    response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked, gzip\r\n\r\n";
+    parseHttpBufferN(response, strlen(response), parser, HTTP_RESPONSE);
+    assert_int(parser->parserStatus, ==, HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING);
+    return MUNIT_OK;
+}
+
+static MunitResult engineHeaderCharsValidationOk(const MunitParameter params[], void *httpDataBuffer) {
+    const char *requests[] = {
+            "GET / HTTP/1.1\r\nX\0A: a\r\n\r\n",
+            "GET / HTTP/1.1\r\nXyzzy-Long-Header-Name-Over-32-Bytes\"B: a\r\n\r\n",    // separator inside bulk scanned name
+            "GET / HTTP/1.1\r\nX-A: a\001b\r\n\r\n",
+            "GET / HTTP/1.1\r\nX-A: a\0b\r\n\r\n"
+    };
+    const size_t requestLengths[] = {26, 61, 28, 28};     // NUL included
+    const uint8_t profiles[] = {HTTP_VALIDATION_STRICT, HTTP_VALIDATION_LENIENT, HTTP_VALIDATION_TRUSTED};
+    const HTTPParserStatus expected[][4] = {
+            {HTTP_PARSE_ERROR_INVALID_HEADER, HTTP_PARSE_ERROR_INVALID_HEADER, HTTP_PARSE_ERROR_INVALID_HEADER, HTTP_PARSE_ERROR_INVALID_HEADER},
+            {HTTP_PARSE_ERROR_INVALID_HEADER, HTTP_PARSE_ERROR_INVALID_HEADER, HTTP_PARSE_OK, HTTP_PARSE_OK},
+            {HTTP_PARSE_OK, HTTP_PARSE_OK, HTTP_PARSE_OK, HTTP_PARSE_OK}
+    };
+
+    for (uint32_t profile = 0; profile < ARRAY_SIZE(profiles); profile++) {
+        parser->validationChecks = profiles[profile];
+        for (uint32_t i = 0; i < ARRAY_SIZE(requests); i++) {
+            parseHttpBufferN(requests[i], requestLengths[i], parser, HTTP_REQUEST);
+            assert_int(parser->parserStatus, ==, expected[profile][i]);
+
+            resetHttpParser(parser, HTTP_REQUEST);
+            HTTPParserStatus status = HTTP_PARSE_NEED_MORE_DATA;
+            for (size_t position = 0; position < requestLengths[i] && status == HTTP_PARSE_NEED_MORE_DATA; position++) {
+                status = httpParserFeed(parser, requests[i] + position, 1);
+            }
+            assert_int(status, ==, expected[profile][i]);
+        }
+    }
+    parser->validationChecks = HTTP_VALIDATION_PROFILE;
+    return MUNIT_OK;
+}
 
 static void httpParserTearDown(void *httpDataBuffer) {
     deleteHttpParser(parser);
@@ -412,6 +1651,27 @@ static char *malformedHttpUriParams[] = {
         NULL
 };
 
+static char *comparableHttpMessages[] = {
+        "GET / HTTP/1.0\r\n\r\n",
+        "GET   /   HTTP/1.0\r\n\r\n",
+        "GET /hoge HTTP/1.1\r\nHost: example.com\r\nCookie: \r\n\r\n",
+        "GET /api/user?id=1&test=1245 HTTP/1.1\r\nContent-Length: 42\r\nTransfer-Encoding: gzip\r\n\r\nbody",
+        "GET /hoge HTTP/1.1\r\nContent-Length: 12345\r\nTransfer-Encoding: chunked, gzip\r\n\r\n",
+        "GET / HTTP/1.0\r\n\r",
+        "GETS / HTTP/1.0\r\n\r\n",
+        "GET  HTTP/1.0\r\n\r\n",
+        "GET /\x7fhello HTTP/1.0\r\n\r\n",
+        "GET / HTTP/2.0\r\n\r\n",
+        "GET / HTTP/1.a\r\n\r\n",
+        "HTTP/1.0 500 Internal Server Error\r\n\r\n",
+        "HTTP/1.1 204 No Content\r\nServer: awselb/2.0\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello",
+        "HTTP/1.1 2000 OK\r\n\r\n",
+        "HTTP/1.1 200 O\r\n\r\n",
+        "HTTP/1.1 200 \r\n\r\n",
+        NULL
+};
+
 static MunitParameterEnum httpTestParameters1[] = {
         {.name = "invalidRequest", .values = malformedHttpRequests},
         END_OF_PARAMETERS
@@ -442,13 +1702,18 @@ static MunitParameterEnum httpTestParameters6[] = {
         END_OF_PARAMETERS
 };
 
+static MunitParameterEnum httpTestParameters7[] = {
+        {.name = "httpMessage", .values = comparableHttpMessages},
+        END_OF_PARAMETERS
+};
+
 static MunitTest httpParserTests[] = {
         {.name = "Test OK  parseHttpBuffer() - Request: Minimal HTTP", .test = minimalHttpRequestOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         {.name = "Test OK  parseHttpBuffer() - Request: Multiline spaces HTTP", .test = multilineSpacesHttpOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         {.name = "Test OK parseHttpBuffer() - Request: Header with empty value", .test = parseEmptyValueHeaderHttpOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         {.name = "Test OK parseHttpBuffer() - Request: Header multi byte value", .test = parseMultiByteValueHeaderHttpOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         {.name = "Test OK parseHttpBuffer() - Request: Header multi line value", .test = parseMultiLineValueHeaderHttpOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
-        {.name = "Test OK parseHttpBuffer() - Request: Header with trailing spaces", .test = parseHeaderWithTrailingSpaceHttpOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test FAIL parseHttpHeaders() - Request: Header with space before colon", .test = parseHeaderWithSpaceBeforeColonHttpError, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         {.name = "Test OK parseHttpBuffer() - Request: Full with headers", .test = parseHttpRequestOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         {.name = "Test OK parseHttpBuffer() - Request: Query parameters", .test = parseHttpRequestQueryParamsOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
 
@@ -467,6 +1732,46 @@ static MunitTest httpParserTests[] = {
         {.name = "Test OK parseHttpBuffer() - Response: Full with headers", .test = parseHttpResponseOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
 
         {.name = "Test FAIL parseHttpBuffer() - Response: Malformed responses", .test = checkInvalidHttpResponse, .setup = httpParserSetup, .tear_down = httpParserTearDown, .parameters = httpTestParameters5},
+
+        {.name = "Test OK parseHttpMessage() - Request: Full with headers", .test = parseHttpMessageRequestOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - Response: Full with headers", .test = parseHttpMessageResponseOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - Same result as parseHttpBuffer()", .test = parseHttpMessageSameAsParseHttpBuffer, .setup = httpParserSetup, .tear_down = httpParserTearDown, .parameters = httpTestParameters7},
+
+        {.name = "Test OK httpParserFeed() - Byte by byte", .test = httpParserFeedByteByByteOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK httpParserFeed() - Split chunks", .test = httpParserFeedChunksOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test FAIL httpParserFeed() - Malformed request", .test = httpParserFeedMalformedFail, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+
+        {.name = "Test OK parseHttpBufferN() - Read only input", .test = parseHttpBufferNReadOnlyOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpBufferN() - Length bound", .test = parseHttpBufferNLengthBoundOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test FAIL parseHttpHeadersN() - Malformed headers", .test = parseMalformedHeadersNFail, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpHeadersN() - Token and field value chars", .test = parseHeadersNCharClassesOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+
+        {.name = "Test OK findHttpHeaderSpan() - Header index lookup and iteration", .test = httpHeaderIndexOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK findHttpHeaderSpan() - Header index overflow", .test = httpHeaderIndexOverflowOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK httpFindHeader() - Lazy single header lookup", .test = httpFindHeaderOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK httpFindHeaderN() - Lookup in not NUL terminated buffer", .test = httpFindHeaderNLengthBoundOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test FAIL parseHttpBufferN() - Whitespace before header colon", .test = headerSpaceBeforeColonFail, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - Request-target spans", .test = requestTargetSpansOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK httpQueryParameterHasNext() - Raw pairs and on demand decoding", .test = httpQueryParameterIteratorOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK normalizeHttpPath() - Decoded path without dot segments", .test = normalizeHttpPathOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK getHttpHeaderId() - Known header slots and unknown list", .test = knownHeaderIdsOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpBuffer() - Header names in any case", .test = headerNameCaseInsensitiveOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK isHttpBodyChunked() - Transfer codings list", .test = transferCodingsOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - 64-bit Content-Length, invalid and repeated values", .test = contentLength64BitOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - skip reason phrase", .test = reasonPhraseSkipOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpBufferN() - validation profiles", .test = validationProfilesOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - Header chars checked by engine", .test = engineHeaderCharsValidationOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - header limits", .test = headerLimitsOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK serializeHttpResponse() - iovec output", .test = httpSerializerOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK decodeHttpChunked() - In place, byte by byte and spans", .test = decodeHttpChunkedOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test FAIL decodeHttpChunked() - Malformed chunks", .test = decodeHttpChunkedFail, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK httpMessageHasNext() - Pipelined messages", .test = pipelinedHttpMessagesOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpBatch() - Per message status", .test = parseHttpBatchOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK getHttpParserInstanceWithAllocator() - Arena allocator", .test = httpParserArenaOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK acquireHttpParser() - Parser pool reuse and double release", .test = httpParserPoolOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK httpParserFeed() - Long tokens in any chunk size", .test = longTokensAnyChunkSizeOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK setHttpScanImplementation() - Same result for all kernels", .test = scanImplementationsSameResultOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
+        {.name = "Test OK parseHttpMessage() - Method word compare", .test = httpMethodWordOk, .setup = httpParserSetup, .tear_down = httpParserTearDown},
         END_OF_TESTS
 };
 
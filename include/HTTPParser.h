@@ -2,6 +2,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#endif
 
 #include "HTTPMethod.h"
 #include "HTTPStatus.h"
@@ -9,14 +15,52 @@
 #include "HashMap.h"
 
 #define HTTP_VERSION_LENGTH 4
-#define HTTP_REQUEST_URI_PATH_LENGTH 80
+#define HTTP_REQUEST_URI_PATH_LENGTH 80    // deprecated, size of removed HTTPParser.uriPath, see getHttpUriPath()
 #define HTTP_TRANSFER_ENCODING_TYPES_LENGTH 35
+#define HTTP_METHOD_BUFFER_LENGTH 8
+#define HTTP_STATUS_CODE_BUFFER_LENGTH 4       // "404 "
+#define HTTP_CONTENT_LENGTH_BUFFER_LENGTH 20   // digits of UINT64_MAX
+
+#ifndef HTTP_REQUEST_TARGET_MAX_LENGTH
+#define HTTP_REQUEST_TARGET_MAX_LENGTH 8192     // default of HTTPParser.maxRequestTargetLength
+#endif
+
+#define HTTP_VALIDATION_STRICT (HTTP_CHECK_REASON_PHRASE | HTTP_CHECK_HEADER_NAME | HTTP_CHECK_HEADER_VALUE | HTTP_CHECK_REQUEST_TARGET)
+#define HTTP_VALIDATION_LENIENT (HTTP_CHECK_HEADER_NAME | HTTP_CHECK_REQUEST_TARGET)     // any reason phrase and value bytes
+#define HTTP_VALIDATION_TRUSTED 0   // delimiters only, for traffic validated upstream
+
+#ifndef HTTP_VALIDATION_PROFILE
+#define HTTP_VALIDATION_PROFILE HTTP_VALIDATION_STRICT  // compiled in checks and default of HTTPParser.validationChecks
+#endif
+
+#ifndef HTTP_HEADER_MAX_COUNT
+#define HTTP_HEADER_MAX_COUNT 100       // default of HTTPParser.maxHeaderCount
+#endif
+
+#ifndef HTTP_HEADER_LINE_MAX_LENGTH
+#define HTTP_HEADER_LINE_MAX_LENGTH 8192    // default of HTTPParser.maxHeaderLineLength
+#endif
+
+#ifndef HTTP_HEADERS_MAX_LENGTH
+#define HTTP_HEADERS_MAX_LENGTH 65536   // default of HTTPParser.maxHeadersLength
+#endif
+
+#ifndef HTTP_HEADER_INDEX_CAPACITY
+#define HTTP_HEADER_INDEX_CAPACITY 32   // headers above capacity are counted, but not indexed
+#endif
 
 typedef enum HTTPParserType {
     HTTP_REQUEST,
     HTTP_RESPONSE
 } HTTPParserType;
 
+typedef enum HTTPValidationCheck {  // optional checks, bits of HTTPParser.validationChecks
+    HTTP_CHECK_REASON_PHRASE = 0x01,    // response reason phrase must match standard one, clients may skip (RFC 9112 4)
+    HTTP_CHECK_HEADER_NAME = 0x02,      // only token chars in copied header names
+    HTTP_CHECK_HEADER_VALUE = 0x04,     // only field-value chars in copied header values
+    HTTP_CHECK_REQUEST_TARGET = 0x08    // no control chars in request-target
+} HTTPValidationCheck;
+
 typedef enum HTTPParserStatus {
     HTTP_PARSE_OK,
     HTTP_PARSE_ERROR_EMPTY_DATA,
@@ -35,26 +79,356 @@ typedef enum HTTPParserStatus {
     HTTP_PARSE_ERROR_STATUS_CODE_MESSAGE_NOT_FOUND,
     HTTP_PARSE_ERROR_INVALID_STATUS_CODE_MESSAGE,
     HTTP_PARSE_ERROR_UNEXPECTED_CONTENT_LENGTH,
-    HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY
+    HTTP_PARSE_ERROR_MALFORMED_MESSAGE_BODY,
+    HTTP_PARSE_NEED_MORE_DATA,                  // message head or chunked body is incomplete, feed next bytes
+    HTTP_PARSE_ERROR_INVALID_CONTENT_LENGTH,    // not only digits, above UINT64_MAX or repeated header
+    HTTP_PARSE_ERROR_TOO_MANY_HEADERS,          // above HTTPParser.maxHeaderCount
+    HTTP_PARSE_ERROR_HEADER_LINE_TOO_LONG,      // header line above HTTPParser.maxHeaderLineLength, line end excluded
+    HTTP_PARSE_ERROR_HEADERS_TOO_LONG,          // header block above HTTPParser.maxHeadersLength, empty line included
+    HTTP_PARSE_ERROR_INVALID_HEADER,            // whitespace before colon, name or value chars rejected by validation checks
+    HTTP_PARSE_ERROR_INVALID_TRANSFER_ENCODING, // chunked not final or repeated, request without final chunked, list too long
+    HTTP_PARSE_ERROR_MAP_NOT_AVAILABLE          // query map on parser with region allocator, use getHttpQueryParameterIterator()
 } HTTPParserStatus;
 
+typedef enum HTTPParserState {  // Single-pass engine position, internal use only
+    HTTP_STATE_START,
+    HTTP_STATE_METHOD,
+    HTTP_STATE_SPACES_BEFORE_URI,
+    HTTP_STATE_URI_PATH,
+    HTTP_STATE_URI_QUERY,
+    HTTP_STATE_URI_FRAGMENT,
+    HTTP_STATE_SPACES_BEFORE_HTTP_CONSTANT,
+    HTTP_STATE_HTTP_CONSTANT,
+    HTTP_STATE_HTTP_VERSION,
+    HTTP_STATE_SPACES_BEFORE_STATUS_CODE,
+    HTTP_STATE_STATUS_CODE,
+    HTTP_STATE_SPACES_BEFORE_STATUS_MESSAGE,
+    HTTP_STATE_STATUS_MESSAGE,
+    HTTP_STATE_REQUEST_LINE_END,
+    HTTP_STATE_LINE_ALMOST_DONE,
+    HTTP_STATE_HEADER_LINE_START,
+    HTTP_STATE_HEADER_NAME,
+    HTTP_STATE_SPACES_BEFORE_HEADER_COLON,
+    HTTP_STATE_SPACES_BEFORE_HEADER_VALUE,
+    HTTP_STATE_HEADER_VALUE,
+    HTTP_STATE_SKIP_HEADER_LINE,
+    HTTP_STATE_HEADERS_ALMOST_DONE,
+    HTTP_STATE_MESSAGE_HEAD_DONE
+} HTTPParserState;
+
+typedef struct HTTPParserScanState {
+    HTTPParserState state;
+    uint16_t tokenLength;           // length of the token being scanned (method, URI path, header name...)
+    uint8_t headerMatchMask;        // well-known header names still matching the current header name
+    uint8_t headerType;             // well-known header of the current line
+    uint8_t seenHeadersMask;        // well-known headers already taken, first occurrence wins
+    uint8_t contentLengthState;     // digits and trailing spaces of Content-Length value
+    uint32_t headerNameOffset;
+    uint32_t headerNameLength;
+    uint32_t lineStartOffset;       // current header line, for line length limit
+    char methodBuffer[HTTP_METHOD_BUFFER_LENGTH];
+    const char *statusCodeMeaning;
+    uint8_t statusMessageMatchLength;
+    uint8_t statusMessageTrailingSpaces;
+    bool isStatusMessageMismatch;
+} HTTPParserScanState;
+
+typedef enum HTTPScanImplementation {   // delimiter scanning kernels of single-pass engine
+    HTTP_SCAN_AUTO,     // best supported by CPU, scalar when HTTP_PARSER_FORCE_SCALAR environment variable is set
+    HTTP_SCAN_SCALAR,
+    HTTP_SCAN_SSE42,
+    HTTP_SCAN_AVX2
+} HTTPScanImplementation;
+
+typedef struct HTTPHeaderSpan {    // name and value position in the parsed message buffer
+    uint32_t nameOffset;
+    uint32_t valueOffset;
+    uint32_t nameLength;
+    uint32_t valueLength;
+} HTTPHeaderSpan;
+
+typedef struct HTTPRequestTarget {     // request-target parts in the parsed message buffer, no copies
+    uint32_t pathOffset;
+    uint32_t pathLength;
+    uint32_t queryOffset;       // after '?', queryLength is 0 when there is no query
+    uint32_t queryLength;
+    uint32_t fragmentOffset;    // after '#'
+    uint32_t fragmentLength;
+} HTTPRequestTarget;
+
+typedef struct HTTPHeaderIterator {
+    const char *name;
+    const char *value;
+    uint32_t nameLength;
+    uint32_t valueLength;
+    const HTTPHeaderSpan *span;
+    const HTTPHeaderSpan *spanEnd;
+    const char *messageBuffer;
+} HTTPHeaderIterator;
+
+typedef struct HTTPQueryParameterIterator {     // raw key and value, nothing is decoded or copied
+    const char *key;
+    const char *value;
+    uint32_t keyLength;
+    uint32_t valueLength;       // 0 for key without '='
+    const char *pointer;
+    const char *end;
+} HTTPQueryParameterIterator;
+
+typedef enum HTTPChunkedState {
+    HTTP_CHUNKED_STATE_SIZE,
+    HTTP_CHUNKED_STATE_EXTENSION,
+    HTTP_CHUNKED_STATE_SIZE_LINE_END,
+    HTTP_CHUNKED_STATE_DATA,
+    HTTP_CHUNKED_STATE_DATA_END,
+    HTTP_CHUNKED_STATE_DATA_LINE_END,
+    HTTP_CHUNKED_STATE_TRAILER_LINE_START,
+    HTTP_CHUNKED_STATE_TRAILER_LINE,
+    HTTP_CHUNKED_STATE_TRAILERS_END,
+    HTTP_CHUNKED_STATE_DONE,
+    HTTP_CHUNKED_STATE_ERROR
+} HTTPChunkedState;
+
+typedef struct HTTPChunkedDecoder {    // keeps position inside chunk framing between buffers
+    HTTPChunkedState state;
+    uint64_t chunkRemaining;
+    uint64_t bodyLength;        // decoded payload bytes in total, framing error instead of wrap
+    size_t decodedLength;       // decoded payload bytes from last call
+    size_t consumedLength;      // input bytes used by last call, rest belongs to next message
+    bool hasChunkSize;
+} HTTPChunkedDecoder;
+
+typedef struct HTTPBodySpan {    // payload position in the buffer passed to decodeHttpChunkedSpans()
+    uint32_t offset;
+    uint32_t length;
+} HTTPBodySpan;
+
+typedef struct HTTPMessageIterator {     // consecutive (pipelined) messages in one buffer
+    const char *data;
+    size_t length;
+    size_t offset;      // start of next message, incomplete rest of buffer when iteration ends
+    HTTPParserType httpType;
+    const char *message;    // current message start, parser offsets are relative to it, NULL before first message
+} HTTPMessageIterator;
+
+typedef enum HTTPHeaderId {     // well-known header names, see getHttpHeaderId()
+    HTTP_HEADER_ID_UNKNOWN,
+    HTTP_HEADER_ID_ACCEPT,
+    HTTP_HEADER_ID_ACCEPT_CHARSET,
+    HTTP_HEADER_ID_ACCEPT_ENCODING,
+    HTTP_HEADER_ID_ACCEPT_LANGUAGE,
+    HTTP_HEADER_ID_ACCEPT_RANGES,
+    HTTP_HEADER_ID_AGE,
+    HTTP_HEADER_ID_ALLOW,
+    HTTP_HEADER_ID_AUTHORIZATION,
+    HTTP_HEADER_ID_CACHE_CONTROL,
+    HTTP_HEADER_ID_CONNECTION,
+    HTTP_HEADER_ID_CONTENT_DISPOSITION,
+    HTTP_HEADER_ID_CONTENT_ENCODING,
+    HTTP_HEADER_ID_CONTENT_LANGUAGE,
+    HTTP_HEADER_ID_CONTENT_LENGTH,
+    HTTP_HEADER_ID_CONTENT_LOCATION,
+    HTTP_HEADER_ID_CONTENT_RANGE,
+    HTTP_HEADER_ID_CONTENT_TYPE,
+    HTTP_HEADER_ID_COOKIE,
+    HTTP_HEADER_ID_DATE,
+    HTTP_HEADER_ID_ETAG,
+    HTTP_HEADER_ID_EXPECT,
+    HTTP_HEADER_ID_EXPIRES,
+    HTTP_HEADER_ID_FORWARDED,
+    HTTP_HEADER_ID_FROM,
+    HTTP_HEADER_ID_HOST,
+    HTTP_HEADER_ID_IF_MATCH,
+    HTTP_HEADER_ID_IF_MODIFIED_SINCE,
+    HTTP_HEADER_ID_IF_NONE_MATCH,
+    HTTP_HEADER_ID_IF_RANGE,
+    HTTP_HEADER_ID_IF_UNMODIFIED_SINCE,
+    HTTP_HEADER_ID_KEEP_ALIVE,
+    HTTP_HEADER_ID_LAST_MODIFIED,
+    HTTP_HEADER_ID_LOCATION,
+    HTTP_HEADER_ID_ORIGIN,
+    HTTP_HEADER_ID_PRAGMA,
+    HTTP_HEADER_ID_PROXY_AUTHORIZATION,
+    HTTP_HEADER_ID_RANGE,
+    HTTP_HEADER_ID_REFERER,
+    HTTP_HEADER_ID_SERVER,
+    HTTP_HEADER_ID_SET_COOKIE,
+    HTTP_HEADER_ID_TE,
+    HTTP_HEADER_ID_TRAILER,
+    HTTP_HEADER_ID_TRANSFER_ENCODING,
+    HTTP_HEADER_ID_UPGRADE,
+    HTTP_HEADER_ID_USER_AGENT,
+    HTTP_HEADER_ID_VARY,
+    HTTP_HEADER_ID_VIA,
+    HTTP_HEADER_ID_WWW_AUTHENTICATE,
+    HTTP_HEADER_ID_X_FORWARDED_FOR,
+    HTTP_HEADER_ID_COUNT
+} HTTPHeaderId;
+
+#if defined(__unix__) || defined(__APPLE__)
+typedef struct iovec HTTPIoVector;  // ready for writev()
+#else
+typedef struct HTTPIoVector {       // same fields as POSIX struct iovec
+    void *iov_base;
+    size_t iov_len;
+} HTTPIoVector;
+#endif
+
+typedef struct HTTPOutputHeader {   // known id takes name from constant table, name is used only for HTTP_HEADER_ID_UNKNOWN
+    HTTPHeaderId id;
+    const char *name;
+    const char *value;
+} HTTPOutputHeader;
+
+typedef struct HTTPBodySegment {    // caller owned body part, referenced without copy
+    const char *data;
+    size_t length;
+} HTTPBodySegment;
+
+typedef struct HTTPSerializer {     // vectors point to constant tables, caller data and number buffers below
+    HTTPIoVector *vectors;
+    uint16_t capacity;
+    uint16_t count;
+    size_t length;                  // bytes in all vectors, for partial writev() handling
+    char statusCode[HTTP_STATUS_CODE_BUFFER_LENGTH];           // status line not in constant table
+    char contentLength[HTTP_CONTENT_LENGTH_BUFFER_LENGTH];     // digits of added header value, no terminator
+} HTTPSerializer;
+
+typedef struct HTTPHeaderEntry {
+    const char *name;
+    const char *value;
+} HTTPHeaderEntry;
+
+typedef struct HTTPParserAllocator {     // memory for parser, storages and unknown headers list
+    void *(*allocate)(void *context, size_t size);
+    void *(*reallocate)(void *context, void *pointer, size_t oldSize, size_t newSize);
+    void (*release)(void *context, void *pointer, size_t size);     // NULL when memory is dropped with whole region
+    void *context;
+} HTTPParserAllocator;
+
+typedef struct HTTPParserArena {    // bump allocator over caller memory, released at once
+    char *data;
+    size_t capacity;
+    size_t used;
+    char *lastAllocation;   // only last allocation can grow in place
+} HTTPParserArena;
+
+typedef struct HTTPParserStorage {     // parser owned copies for non-destructive parsing
+    char *data;
+    uint32_t capacity;
+} HTTPParserStorage;
+
 typedef struct HTTPParser {
     char httpVersion[HTTP_VERSION_LENGTH];
-    uint32_t contentLength;
+    uint64_t contentLength;
     HTTPMethod method;
     HTTPStatus statusCode;
-    char uriPath[HTTP_REQUEST_URI_PATH_LENGTH];
+    HTTPRequestTarget requestTarget;
+    uint32_t maxRequestTargetLength;    // longer targets fail with HTTP_PARSE_ERROR_URI_PATH_TOO_LONG, kept by resets
+    uint8_t validationChecks;           // HTTPValidationCheck bits, kept by resets, only compiled in ones are applied
+    uint16_t maxHeaderCount;            // header limits, kept by resets, exceeded one stops parsing with its own status
+    uint32_t maxHeaderLineLength;
+    uint32_t maxHeadersLength;
     char transferEncodingTypes[HTTP_TRANSFER_ENCODING_TYPES_LENGTH];
     char *messageBody;
     HTTPParserType httpType;
-    HashMap headers;
-    HashMap queryParameters;
+    HashMap headers;            // NULL for parser with region allocator (release is NULL), HashMap mallocs its own memory
+    HashMap queryParameters;    // same as headers
+    HTTPParserStorage headersStorage;
+    HTTPParserStorage queryParametersStorage;
+    HTTPParserAllocator allocator;
+    const struct HTTPParserPool *pool;  // owner pool, NULL for standalone parser
+    bool isPooled;                      // waits in owner pool free list, releases are rejected
+    const char *knownHeaders[HTTP_HEADER_ID_COUNT];    // header values by HTTPHeaderId, NULL when absent
+    uint64_t knownHeadersMask;                         // set slots of knownHeaders, cleared one by one
+    HTTPHeaderEntry *unknownHeaders;                   // overflow list for names without HTTPHeaderId
+    uint16_t unknownHeaderCount;
+    uint16_t unknownHeaderCapacity;
     HTTPParserStatus parserStatus;
+    uint32_t headersStartOffset;    // first header line, relative to message start
+    uint32_t headersEndOffset;      // empty line that terminates headers
+    uint32_t messageBodyOffset;
+    uint32_t messageBodyLength;     // framed body bytes, chunk framing included
+    uint32_t messageLength;         // head and body, next pipelined message starts here
+    uint32_t parsedLength;          // bytes consumed from message start, never scanned again
+    uint16_t headerCount;
+    HTTPHeaderSpan headerIndex[HTTP_HEADER_INDEX_CAPACITY];
+    HTTPChunkedDecoder chunkedDecoder;
+    HTTPParserScanState scan;
 } HTTPParser;
 
+typedef struct HTTPParserPool {     // pre-initialized parsers reused between connections
+    HTTPParserAllocator allocator;
+    uint16_t capacity;
+    uint16_t freeCount;
+    HTTPParser *freeParsers[];
+} HTTPParserPool;
+
 
 HTTPParser *getHttpParserInstance();
+HTTPParser *getHttpParserInstanceWithAllocator(const HTTPParserAllocator *allocator);     // NULL allocator for malloc()
 void parseHttpBuffer(char *httpDataBuffer, HTTPParser *httpParser, HTTPParserType httpType);
-void parseHttpHeaders(HTTPParser *httpParser, char *dataBuffer);
-void parseHttpQueryParameters(HTTPParser *httpParser, char *url);
+void parseHttpMessage(const char *httpDataBuffer, HTTPParser *httpParser, HTTPParserType httpType);   // single-pass engine
+void resetHttpParser(HTTPParser *httpParser, HTTPParserType httpType);     // clears only what last parse wrote, parser from getHttpParserInstance()
+HTTPParserStatus httpParserFeed(HTTPParser *httpParser, const char *data, size_t length);
+void parseHttpHeaders(HTTPParser *httpParser, char *dataBuffer);     // region allocator: known/unknown headers only, no "headers" map
+void parseHttpQueryParameters(HTTPParser *httpParser, char *url);   // region allocator: fails with HTTP_PARSE_ERROR_MAP_NOT_AVAILABLE
+
+// Length bounded versions, input is never modified and never read past length
+void parseHttpBufferN(const char *data, size_t length, HTTPParser *httpParser, HTTPParserType httpType);
+void parseHttpHeadersN(HTTPParser *httpParser, const char *data, size_t length);
+void parseHttpQueryParametersN(HTTPParser *httpParser, const char *url, size_t length);
+size_t parseHttpBatch(const char *const buffers[], const size_t lengths[], HTTPParser *const parsers[], size_t count, HTTPParserType httpType);    // returns count of HTTP_PARSE_OK
+
+// Zero-copy header index filled by parseHttpMessage(), parseHttpBufferN() and httpParserFeed()
+const HTTPHeaderSpan *findHttpHeaderSpan(const HTTPParser *httpParser, const char *messageBuffer, const char *name);
+HTTPHeaderIterator getHttpHeaderIterator(const HTTPParser *httpParser, const char *messageBuffer);
+bool httpHeaderHasNext(HTTPHeaderIterator *iterator);
+void parseHttpHeadersFromIndex(HTTPParser *httpParser, const char *messageBuffer);     // fills "headers" map only on demand
+HTTPHeaderSpan httpFindHeader(HTTPParser *httpParser, const char *messageBuffer, const char *name);    // nameLength 0 when not found
+HTTPHeaderSpan httpFindHeaderN(HTTPParser *httpParser, const char *messageBuffer, size_t length, const char *name);  // never reads past length
+
+// Zero-copy query parameters, percent-decoding only for values actually read
+HTTPQueryParameterIterator getHttpQueryParameterIterator(const HTTPParser *httpParser, const char *messageBuffer);    // query of requestTarget
+HTTPQueryParameterIterator getHttpQueryStringIterator(const char *query, size_t length);   // "a=1&b=2", e.g. form body
+bool httpQueryParameterHasNext(HTTPQueryParameterIterator *iterator);
+bool decodeHttpQueryComponent(const char *data, size_t length, char *buffer, size_t bufferSize, size_t *decodedLength);   // false on bad escape or small buffer
+
+// Percent-decoded path without "." and ".." segments and duplicate slashes, "%2F" stays escaped, "%00" fails
+bool normalizeHttpRequestPath(const HTTPParser *httpParser, const char *messageBuffer, char *buffer, size_t bufferSize, size_t *normalizedLength);
+bool normalizeHttpPath(const char *path, size_t length, char *buffer, size_t bufferSize, size_t *normalizedLength);
+// Deprecated, copy of requestTarget path as removed HTTPParser.uriPath had, NUL terminated, false when it does not fit
+bool getHttpUriPath(const HTTPParser *httpParser, const char *messageBuffer, char *buffer, size_t bufferSize);
+
+HTTPHeaderId getHttpHeaderId(const char *name, size_t length);     // HTTP_HEADER_ID_UNKNOWN for other names
+const char *findHttpHeaderValue(const HTTPParser *httpParser, const char *name);   // any name case, after parseHttpHeaders*(), NULL when absent
+
+HTTPMessageIterator getHttpMessageIterator(const char *data, size_t length, HTTPParserType httpType);
+bool httpMessageHasNext(HTTPMessageIterator *iterator, HTTPParser *httpParser);   // false on end, incomplete or malformed message
+
+bool isHttpBodyChunked(const HTTPParser *httpParser);
+void resetHttpChunkedDecoder(HTTPChunkedDecoder *decoder);
+HTTPParserStatus decodeHttpChunked(HTTPChunkedDecoder *decoder, char *data, size_t length);    // payload compacted to data start
+HTTPParserStatus decodeHttpChunkedSpans(HTTPChunkedDecoder *decoder, const char *data, size_t length,
+                                        HTTPBodySpan *spans, uint16_t spanCapacity, uint16_t *spanCount);
+
+bool setHttpScanImplementation(HTTPScanImplementation implementation);    // false when not supported by CPU, not thread-safe: call before parsing threads start
+HTTPScanImplementation getHttpScanImplementation();
+
+HTTPParserPool *getHttpParserPoolInstance(uint16_t capacity, const HTTPParserAllocator *allocator);  // NULL allocator for malloc()
+HTTPParser *acquireHttpParser(HTTPParserPool *pool);    // NULL when all parsers are in use
+bool releaseHttpParser(HTTPParserPool *pool, HTTPParser *httpParser);  // false for foreign or already released parser
+void deleteHttpParserPool(HTTPParserPool *pool);       // parsers still acquired are not deleted
+
+void initHttpParserArena(HTTPParserArena *arena, void *memory, size_t capacity);
+HTTPParserAllocator getHttpParserArenaAllocator(HTTPParserArena *arena);
+void resetHttpParserArena(HTTPParserArena *arena);     // releases every parser allocated from arena
+
+// Scatter-gather HTTP/1.1 output, Content-Length is added for non-empty body without Content-Length or Transfer-Encoding header
+void initHttpSerializer(HTTPSerializer *serializer, HTTPIoVector *vectors, uint16_t capacity);
+uint16_t serializeHttpResponse(HTTPSerializer *serializer, HTTPStatus statusCode, const HTTPOutputHeader *headers, uint16_t headerCount,
+                               const HTTPBodySegment *body, uint16_t bodyCount);   // vector count, 0 on small capacity or invalid status
+uint16_t serializeHttpRequest(HTTPSerializer *serializer, HTTPMethod method, const char *target, const HTTPOutputHeader *headers, uint16_t headerCount,
+                              const HTTPBodySegment *body, uint16_t bodyCount);    // vector count, 0 on small capacity or invalid method
+
 void deleteHttpParser(HTTPParser *httpParser);
\ No newline at end of file